@@ -0,0 +1,98 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+
+#include "AI/GameplayDebuggerCategory_UDCoreMove.h"
+
+#if WITH_GAMEPLAY_DEBUGGER
+
+#include "AI/UDCoreMoveSubsystem.h"
+#include "AIController.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "NavigationData.h"
+
+void FGameplayDebuggerCategory_UDCoreMove::FRepData::Serialize(FArchive& Ar)
+{
+	Ar << NumActiveMoves;
+	Ar << bHasMoveRequest;
+	Ar << RequestId;
+	Ar << Destination;
+	Ar << AcceptanceRadius;
+	Ar << ElapsedTime;
+	Ar << PathLength;
+	Ar << TravelledDistance;
+	Ar << NumRepaths;
+	Ar << NumStuckEvents;
+}
+
+FGameplayDebuggerCategory_UDCoreMove::FGameplayDebuggerCategory_UDCoreMove()
+{
+	SetDataPackReplication<FRepData>(&DataPack);
+}
+
+TSharedRef<FGameplayDebuggerCategory> FGameplayDebuggerCategory_UDCoreMove::MakeInstance()
+{
+	return MakeShareable(new FGameplayDebuggerCategory_UDCoreMove());
+}
+
+void FGameplayDebuggerCategory_UDCoreMove::CollectData(APlayerController* OwnerPC, AActor* DebugActor)
+{
+	DataPack = FRepData();
+
+	const UWorld* World = DebugActor ? DebugActor->GetWorld() : nullptr;
+	const UUDCoreMoveSubsystem* MoveSubsystem = World ? World->GetSubsystem<UUDCoreMoveSubsystem>() : nullptr;
+	if (!MoveSubsystem) { return; }
+
+	DataPack.NumActiveMoves = MoveSubsystem->GetNumActiveMoves();
+
+	const APawn* Pawn = Cast<APawn>(DebugActor);
+	const AController* Controller = Pawn ? Pawn->GetController() : Cast<AController>(DebugActor);
+	if (!Controller) { return; }
+
+	const FUDMoveRequestHandle Handle = MoveSubsystem->FindMoveRequest(Controller);
+	const FUDMoveRequestTelemetry* Telemetry = MoveSubsystem->GetMoveTelemetry(Handle);
+	if (!Telemetry || !MoveSubsystem->GetMoveDestination(Handle, DataPack.Destination, DataPack.AcceptanceRadius)) { return; }
+
+	DataPack.bHasMoveRequest = true;
+	DataPack.RequestId = Handle.Id;
+	DataPack.ElapsedTime = World->GetTimeSeconds() - Telemetry->StartTime;
+	DataPack.PathLength = Telemetry->PathLength;
+	DataPack.TravelledDistance = Telemetry->TravelledDistance;
+	DataPack.NumRepaths = Telemetry->NumRepaths;
+	DataPack.NumStuckEvents = Telemetry->NumStuckEvents;
+
+	// Draw the path being followed, the category is only collected while enabled so walking it here is fine.
+	const UPathFollowingComponent* PathFollowingComponent = Controller->FindComponentByClass<UPathFollowingComponent>();
+	const FNavPathSharedPtr Path = PathFollowingComponent ? PathFollowingComponent->GetPath() : nullptr;
+	if (Path.IsValid() && Path->IsValid())
+	{
+		const TArray<FNavPathPoint>& PathPoints = Path->GetPathPoints();
+		for (int32 PointIndex = 1; PointIndex < PathPoints.Num(); ++PointIndex)
+		{
+			AddShape(FGameplayDebuggerShape::MakeSegment(PathPoints[PointIndex - 1].Location, PathPoints[PointIndex].Location, 3.0f, FColor::Cyan));
+		}
+	}
+
+	AddShape(FGameplayDebuggerShape::MakeCylinder(DataPack.Destination, DataPack.AcceptanceRadius, 10.0f, FColor::Green));
+}
+
+void FGameplayDebuggerCategory_UDCoreMove::DrawData(APlayerController* OwnerPC, FGameplayDebuggerCanvasContext& CanvasContext)
+{
+	CanvasContext.Printf(TEXT("Active move requests: {yellow}%d"), DataPack.NumActiveMoves);
+
+	if (!DataPack.bHasMoveRequest)
+	{
+		CanvasContext.Printf(TEXT("{grey}No active move request for the debug actor."));
+		return;
+	}
+
+	CanvasContext.Printf(TEXT("Request: {yellow}%u{white}  Elapsed: {yellow}%.2fs"), DataPack.RequestId, DataPack.ElapsedTime);
+	CanvasContext.Printf(TEXT("Path length: {yellow}%.0f{white}  Travelled: {yellow}%.0f"), DataPack.PathLength, DataPack.TravelledDistance);
+	CanvasContext.Printf(TEXT("Repaths: {yellow}%d{white}  Stuck events: %s%d"),
+		DataPack.NumRepaths,
+		DataPack.NumStuckEvents > 0 ? TEXT("{red}") : TEXT("{yellow}"),
+		DataPack.NumStuckEvents);
+}
+
+#endif // WITH_GAMEPLAY_DEBUGGER
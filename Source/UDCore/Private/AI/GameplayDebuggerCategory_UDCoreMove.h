@@ -0,0 +1,46 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+#pragma once
+
+#if WITH_GAMEPLAY_DEBUGGER
+
+#include "CoreMinimal.h"
+#include "GameplayDebuggerCategory.h"
+
+class APlayerController;
+
+/**
+ * Gameplay Debugger category showing the move request of the debugged actor.
+ * The data is only collected while the category is enabled, so the move subsystem pays nothing for it otherwise.
+ */
+class FGameplayDebuggerCategory_UDCoreMove : public FGameplayDebuggerCategory
+{
+public:
+	FGameplayDebuggerCategory_UDCoreMove();
+
+	virtual void CollectData(APlayerController* OwnerPC, AActor* DebugActor) override;
+	virtual void DrawData(APlayerController* OwnerPC, FGameplayDebuggerCanvasContext& CanvasContext) override;
+
+	static TSharedRef<FGameplayDebuggerCategory> MakeInstance();
+
+protected:
+	struct FRepData
+	{
+		int32 NumActiveMoves = 0;
+		bool bHasMoveRequest = false;
+		uint32 RequestId = 0;
+		FVector Destination = FVector::ZeroVector;
+		float AcceptanceRadius = 0.0f;
+		float ElapsedTime = 0.0f;
+		float PathLength = 0.0f;
+		float TravelledDistance = 0.0f;
+		uint16 NumRepaths = 0;
+		uint16 NumStuckEvents = 0;
+
+		void Serialize(FArchive& Ar);
+	};
+
+	FRepData DataPack;
+};
+
+#endif // WITH_GAMEPLAY_DEBUGGER
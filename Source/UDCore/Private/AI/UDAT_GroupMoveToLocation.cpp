@@ -0,0 +1,179 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+
+#include "AI/UDAT_GroupMoveToLocation.h"
+#include "UDCoreLogChannels.h"
+#include "Engine/World.h"
+#include "DrawDebugHelpers.h"
+
+
+UUDAT_GroupMoveToLocation* UUDAT_GroupMoveToLocation::GroupMoveToLocation(
+	UObject* WorldContextObject,
+	const TArray<AController*>& Controllers,
+	const FVector Destination,
+	const float FormationSpacing,
+	const float AcceptanceRadius,
+	const bool bCheckStuckMovement,
+	const float StuckThreshold,
+	const float MaxSharedPathDistance,
+	const bool bDebugLineTrace,
+	const bool bUseAsyncPathfinding)
+{
+	UUDAT_GroupMoveToLocation* Action = UUDCoreLatentActionPool::NewAction<UUDAT_GroupMoveToLocation>(WorldContextObject);
+	Action->bActive = true;
+	Action->Controllers = Controllers;
+	Action->Destination = Destination;
+	Action->FormationSpacing = FormationSpacing;
+	Action->AcceptanceRadius = AcceptanceRadius;
+	Action->bCheckStuckMovement = bCheckStuckMovement;
+	Action->StuckThreshold = StuckThreshold;
+	Action->MaxSharedPathDistance = MaxSharedPathDistance;
+	Action->bDebugLineTrace = bDebugLineTrace;
+	Action->bUseAsyncPathfinding = bUseAsyncPathfinding;
+
+	Action->RegisterWithGameInstance(WorldContextObject);
+
+	return Action;
+}
+
+
+void UUDAT_GroupMoveToLocation::EndTask()
+{
+	ExecuteCompleted(false);
+}
+
+void UUDAT_GroupMoveToLocation::Activate()
+{
+	const UWorld* World = nullptr;
+	for (const AController* Controller : Controllers)
+	{
+		if (Controller)
+		{
+			World = Controller->GetWorld();
+			break;
+		}
+	}
+
+	MoveSubsystem = UWorld::GetSubsystem<UUDCoreMoveSubsystem>(World);
+	if (!MoveSubsystem.IsValid())
+	{
+		UE_LOG(LogUDCore, Warning, TEXT("No move subsystem found to move the group to location. Aborting."));
+		ExecuteCompleted(false);
+		return;
+	}
+
+	FUDMoveRequestParams Params;
+	Params.Destination = Destination;
+	Params.AcceptanceRadius = AcceptanceRadius;
+	Params.bCheckStuckMovement = bCheckStuckMovement;
+	Params.StuckThreshold = StuckThreshold;
+	Params.bUseAsyncPathfinding = bUseAsyncPathfinding;
+
+	MoveHandles = MoveSubsystem->RequestGroupMove(
+		Controllers,
+		Params,
+		FormationSpacing,
+		MaxSharedPathDistance,
+		FOnUDMoveRequestCompleted::CreateUObject(this, &UUDAT_GroupMoveToLocation::OnMemberMoveRequestCompleted));
+
+	for (int32 Member = 0; Member < MoveHandles.Num(); ++Member)
+	{
+		if (MoveHandles[Member].IsValid())
+		{
+			++NumMoving;
+			continue;
+		}
+
+		// Controllers without a pawn fail right away.
+		++NumFailed;
+		MemberCompleted.Broadcast(Controllers[Member], false);
+	}
+
+	if (NumMoving == 0)
+	{
+		UE_LOG(LogUDCore, Warning, TEXT("No controller of the group has a pawn to move to location. Aborting."));
+		ExecuteCompleted(false);
+		return;
+	}
+
+	UE_LOG(LogUDCore, Verbose, TEXT("Moving %i controllers to location (%s)."), NumMoving, *Destination.ToString());
+
+	if (bDebugLineTrace)
+	{
+		DrawDebugLine(
+			World,
+			Destination + FVector(0, 0, 100),
+			Destination,
+			FColor::Green,
+			false,
+			5.0f,
+			0,
+			1.0f
+		);
+	}
+}
+
+void UUDAT_GroupMoveToLocation::ResetForPool()
+{
+	MemberCompleted.Clear();
+	Completed.Clear();
+	Controllers.Empty();
+	Destination = FVector::ZeroVector;
+	FormationSpacing = 150.0f;
+	AcceptanceRadius = 100.0f;
+	bCheckStuckMovement = true;
+	StuckThreshold = 1.0f;
+	MaxSharedPathDistance = 1000.0f;
+	bDebugLineTrace = false;
+	bUseAsyncPathfinding = false;
+	MoveSubsystem.Reset();
+	MoveHandles.Empty();
+	NumMoving = 0;
+	NumFailed = 0;
+	bActive = false;
+}
+
+void UUDAT_GroupMoveToLocation::OnMemberMoveRequestCompleted(const FUDMoveRequestHandle Handle, const bool bSuccess)
+{
+	const int32 Member = MoveHandles.IndexOfByKey(Handle);
+	if (Member == INDEX_NONE) { return; }
+
+	MoveHandles[Member].Invalidate();
+	--NumMoving;
+	NumFailed += bSuccess ? 0 : 1;
+
+	MemberCompleted.Broadcast(Controllers[Member], bSuccess);
+
+	if (NumMoving == 0)
+	{
+		ExecuteCompleted(NumFailed == 0);
+	}
+}
+
+void UUDAT_GroupMoveToLocation::ExecuteCompleted(const bool bSuccess)
+{
+	if (!bActive) { return; }
+	bActive = false;
+
+	UE_LOG(LogUDCore, Log, TEXT("Group movement to location completed. Success: %s."), bSuccess ? TEXT("true") : TEXT("false"));
+
+	// Stop the controllers still moving when the task is ended early.
+	for (FUDMoveRequestHandle& MoveHandle : MoveHandles)
+	{
+		if (MoveHandle.IsValid() && MoveSubsystem.IsValid())
+		{
+			MoveSubsystem->CancelMove(MoveHandle);
+		}
+		MoveHandle.Invalidate();
+	}
+
+	Completed.Broadcast(bSuccess);
+
+	Controllers.Empty();
+	MoveHandles.Empty();
+	NumMoving = 0;
+	Destination = FVector::ZeroVector;
+
+	SetReadyToDestroy();
+	UUDCoreLatentActionPool::ReleaseAction(this);
+}
@@ -3,10 +3,8 @@
 
 #include "AI/UDAT_MoveToLocation.h"
 #include "UDCoreLogChannels.h"
-#include "Blueprint/AIBlueprintHelperLibrary.h"
 #include "Engine/World.h"
 #include "DrawDebugHelpers.h"
-#include "TimerManager.h"
 
 
 UUDAT_MoveToLocation* UUDAT_MoveToLocation::MoveToLocation(
@@ -16,21 +14,51 @@ UUDAT_MoveToLocation* UUDAT_MoveToLocation::MoveToLocation(
 	const float AcceptanceRadius,
 	const bool bCheckStuckMovement,
 	const float StuckThreshold,
-	const bool bDebugLineTrace)
+	const bool bDebugLineTrace,
+	const bool bUseAsyncPathfinding)
 {
-	UUDAT_MoveToLocation* Action = NewObject<UUDAT_MoveToLocation>();
+	UUDAT_MoveToLocation* Action = UUDCoreLatentActionPool::NewAction<UUDAT_MoveToLocation>(WorldContextObject);
+	Action->bActive = true;
 	Action->Controller = Controller;
 	Action->Destination = Destination;
 	Action->AcceptanceRadius = AcceptanceRadius;
 	Action->bDebugLineTrace = bDebugLineTrace;
 	Action->StuckThreshold = StuckThreshold;
 	Action->bCheckStuckMovement = bCheckStuckMovement;
+	Action->bUseAsyncPathfinding = bUseAsyncPathfinding;
 
 	Action->RegisterWithGameInstance(WorldContextObject);
 
 	return Action;
 }
 
+UUDAT_MoveToLocation* UUDAT_MoveToLocation::FollowActor(
+	UObject* WorldContextObject,
+	AController* Controller,
+	AActor* TargetActor,
+	const float AcceptanceRadius,
+	const float RepathDistance,
+	const bool bCheckStuckMovement,
+	const float StuckThreshold,
+	const bool bDebugLineTrace,
+	const bool bUseAsyncPathfinding)
+{
+	UUDAT_MoveToLocation* Action = MoveToLocation(
+		WorldContextObject,
+		Controller,
+		TargetActor ? TargetActor->GetActorLocation() : FVector::ZeroVector,
+		AcceptanceRadius,
+		bCheckStuckMovement,
+		StuckThreshold,
+		bDebugLineTrace,
+		bUseAsyncPathfinding);
+	Action->bFollowTargetActor = true;
+	Action->TargetActor = TargetActor;
+	Action->RepathDistance = RepathDistance;
+
+	return Action;
+}
+
 
 void UUDAT_MoveToLocation::EndTask()
 {
@@ -39,24 +67,47 @@ void UUDAT_MoveToLocation::EndTask()
 
 void UUDAT_MoveToLocation::Activate()
 {
-	if(!Controller || !Controller->GetPawn())
+	UUDCoreMoveSubsystem* MoveSubsystem = Controller ? UWorld::GetSubsystem<UUDCoreMoveSubsystem>(Controller->GetWorld()) : nullptr;
+	const bool bTargetActorLost = bFollowTargetActor && !TargetActor.IsValid();
+	if (MoveSubsystem && !bTargetActorLost)
 	{
+		FUDMoveRequestParams Params;
+		Params.Destination = Destination;
+		Params.AcceptanceRadius = AcceptanceRadius;
+		Params.bCheckStuckMovement = bCheckStuckMovement;
+		Params.StuckThreshold = StuckThreshold;
+		Params.bUseAsyncPathfinding = bUseAsyncPathfinding;
+		Params.TargetActor = TargetActor;
+		Params.RepathDistance = RepathDistance;
+
+		MoveHandle = MoveSubsystem->RequestMove(
+			Controller,
+			Params,
+			FOnUDMoveRequestCompleted::CreateUObject(this, &UUDAT_MoveToLocation::OnMoveRequestCompleted));
+	}
+
+	if (Controller && !MoveSubsystem)
+	{
+		UE_LOG(
+			LogUDCore,
+			Warning,
+			TEXT("No move subsystem found in world %s to move the controller to location. It only exists in game and PIE worlds. Aborting."),
+			*GetNameSafe(Controller->GetWorld()));
 		ExecuteCompleted(false);
-		UE_LOG(LogUDCore, Warning, TEXT("Controller or pawn has been destroyed while moving to location. Aborting."));
 		return;
 	}
-	
-	StartLocation = Controller->GetPawn()->GetActorLocation();
-	LastCheckedLocation = StartLocation;
-	
-	Controller->GetWorld()->GetTimerManager().SetTimer(TimerHandle, this, &UUDAT_MoveToLocation::CheckMoveToLocation, 0.1f, true);
 
-	if (bCheckStuckMovement)
+	if (!MoveHandle.IsValid())
 	{
-		Controller->GetWorld()->GetTimerManager().SetTimer(StuckTimerHandle, this, &UUDAT_MoveToLocation::CheckStuckMovement, 3.f, true);
+		ExecuteCompleted(false);
+		UE_LOG(
+			LogUDCore,
+			Warning,
+			TEXT("%s has been destroyed while moving to location. Aborting."),
+			bTargetActorLost ? TEXT("Target actor") : TEXT("Controller or pawn"));
+		return;
 	}
-	
-	UAIBlueprintHelperLibrary::SimpleMoveToLocation(Controller, Destination);
+
 	UE_LOG(LogUDCore, Verbose, TEXT("Moving controller to location (%s)."), *Destination.ToString());
 
 	if (bDebugLineTrace)
@@ -74,58 +125,52 @@ void UUDAT_MoveToLocation::Activate()
 	}
 }
 
-void UUDAT_MoveToLocation::CheckMoveToLocation()
+void UUDAT_MoveToLocation::ResetForPool()
 {
-
-	if(!Controller || !Controller->GetPawn())
-	{
-		ExecuteCompleted(false);
-		UE_LOG(LogUDCore, Warning, TEXT("Controller or pawn has been destroyed while moving to location. Aborting."));
-		return;
-	}
-	
-	CurrentLocation = Controller->GetPawn()->GetActorLocation();
-	UE_LOG(LogUDCore, Verbose, TEXT("Controller is moving to location (%s). Current distance: %f."), *Destination.ToString(), FVector::Dist(CurrentLocation, Destination));
-	
-	if (FVector::Dist(CurrentLocation, Destination) < AcceptanceRadius)
-	{
-		UE_LOG(LogUDCore, Verbose, TEXT("Controller has moved to location."));
-		ExecuteCompleted(true);
-	}
+	Completed.Clear();
+	Controller = nullptr;
+	Destination = FVector::ZeroVector;
+	AcceptanceRadius = 10.0f;
+	bCheckStuckMovement = true;
+	StuckThreshold = 1.0f;
+	bDebugLineTrace = false;
+	bUseAsyncPathfinding = false;
+	bFollowTargetActor = false;
+	TargetActor.Reset();
+	RepathDistance = 200.0f;
+	MoveHandle.Invalidate();
+	bActive = false;
 }
 
-void UUDAT_MoveToLocation::CheckStuckMovement()
+void UUDAT_MoveToLocation::OnMoveRequestCompleted(const FUDMoveRequestHandle Handle, const bool bSuccess)
 {
-	if(!Controller || !Controller->GetPawn())
-	{
-		// Controller or pawn has been destroyed
-		ExecuteCompleted(false);
-		UE_LOG(LogUDCore, Warning, TEXT("Controller or pawn has been destroyed while moving to location. Aborting."));
-		return;
-	}
+	if (Handle != MoveHandle) { return; }
 
-	if (FVector::Dist(CurrentLocation, LastCheckedLocation) < StuckThreshold)
-	{
-		// Controller is stuck
-		UE_LOG(LogUDCore, Warning, TEXT("Controller is stuck while moving to location. Aborting"));
-		ExecuteCompleted(false);
-	}
-
-	LastCheckedLocation = CurrentLocation;
+	MoveHandle.Invalidate();
+	ExecuteCompleted(bSuccess);
 }
 
 void UUDAT_MoveToLocation::ExecuteCompleted(const bool bSuccess)
 {
+	if (!bActive) { return; }
+	bActive = false;
+
 	UE_LOG(LogUDCore, Log, TEXT("Movement to location completed. Success: %s."), bSuccess ? TEXT("true") : TEXT("false"));
-	
-	Controller->GetWorld()->GetTimerManager().ClearTimer(TimerHandle);
-	Controller->GetWorld()->GetTimerManager().ClearTimer(StuckTimerHandle);
-	
+
+	if (MoveHandle.IsValid())
+	{
+		if (UUDCoreMoveSubsystem* MoveSubsystem = Controller ? UWorld::GetSubsystem<UUDCoreMoveSubsystem>(Controller->GetWorld()) : nullptr)
+		{
+			MoveSubsystem->CancelMove(MoveHandle);
+		}
+		MoveHandle.Invalidate();
+	}
+
 	Completed.Broadcast(bSuccess);
 	
 	Controller = nullptr;
 	Destination = FVector::ZeroVector;
 	
 	SetReadyToDestroy();
+	UUDCoreLatentActionPool::ReleaseAction(this);
 }
-
@@ -0,0 +1,1255 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+
+#include "AI/UDCoreMoveSubsystem.h"
+#include "UDCoreLogChannels.h"
+#include "UDCoreStats.h"
+#include "UDCoreCompatibility.h"
+#include "Blueprint/AIBlueprintHelperLibrary.h"
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PawnMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "AIController.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "Trace/Trace.inl"
+
+DECLARE_CYCLE_STAT(TEXT("Check Move Requests"), STAT_UDCoreCheckMoveRequests, STATGROUP_UDCore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Move Requests"), STAT_UDCoreActiveMoveRequests, STATGROUP_UDCore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Move Checks"), STAT_UDCoreMoveChecks, STATGROUP_UDCore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Deferred Move Checks"), STAT_UDCoreDeferredMoveChecks, STATGROUP_UDCore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Async Path Queries"), STAT_UDCoreAsyncPathQueries, STATGROUP_UDCore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Low Fidelity Move Requests"), STAT_UDCoreLowFidelityMoveRequests, STATGROUP_UDCore);
+
+TRACE_DECLARE_INT_COUNTER(UDCoreActiveMoveRequests, TEXT("UDCore/Move/Active Requests"));
+TRACE_DECLARE_INT_COUNTER(UDCoreMoveChecks, TEXT("UDCore/Move/Checks"));
+
+UE_TRACE_CHANNEL_DEFINE(UDCoreMoveChannel)
+
+UE_TRACE_EVENT_BEGIN(UDCoreMove, MoveCompleted)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, RequestId)
+	UE_TRACE_EVENT_FIELD(bool, bSuccess)
+	UE_TRACE_EVENT_FIELD(double, TimeToArrival)
+	UE_TRACE_EVENT_FIELD(float, PathLength)
+	UE_TRACE_EVENT_FIELD(float, TravelledDistance)
+	UE_TRACE_EVENT_FIELD(uint16, NumRepaths)
+	UE_TRACE_EVENT_FIELD(uint16, NumStuckEvents)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(UDCoreMove, MoveStuck)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, RequestId)
+	UE_TRACE_EVENT_FIELD(double, LocationX)
+	UE_TRACE_EVENT_FIELD(double, LocationY)
+	UE_TRACE_EVENT_FIELD(double, LocationZ)
+	UE_TRACE_EVENT_FIELD(bool, bRepathing)
+UE_TRACE_EVENT_END()
+
+namespace
+{
+	float GMoveFrameBudgetUs = 200.0f;
+	FAutoConsoleVariableRef CVarMoveFrameBudgetUs(
+		TEXT("UDCore.Move.FrameBudgetUs"),
+		GMoveFrameBudgetUs,
+		TEXT("The time in microseconds the move subsystem may spend checking move requests each frame. 0 disables the budget."));
+
+	float GMoveMinCheckInterval = 0.05f;
+	FAutoConsoleVariableRef CVarMoveMinCheckInterval(
+		TEXT("UDCore.Move.MinCheckInterval"),
+		GMoveMinCheckInterval,
+		TEXT("The shortest interval in seconds between two arrival checks of a move request, used when the agent is about to arrive."));
+
+	float GMoveMaxCheckInterval = 1.0f;
+	FAutoConsoleVariableRef CVarMoveMaxCheckInterval(
+		TEXT("UDCore.Move.MaxCheckInterval"),
+		GMoveMaxCheckInterval,
+		TEXT("The longest interval in seconds between two arrival checks of a move request, used when the agent is far away or slow."));
+
+	int32 GMoveMaxPathQueriesPerFrame = 16;
+	FAutoConsoleVariableRef CVarMoveMaxPathQueriesPerFrame(
+		TEXT("UDCore.Move.MaxPathQueriesPerFrame"),
+		GMoveMaxPathQueriesPerFrame,
+		TEXT("The number of asynchronous path queries the move subsystem may send each frame. 0 removes the limit."));
+
+	float GMoveStuckDetectionLatency = 2.0f;
+	FAutoConsoleVariableRef CVarMoveStuckDetectionLatency(
+		TEXT("UDCore.Move.StuckDetectionLatency"),
+		GMoveStuckDetectionLatency,
+		TEXT("The time in seconds covered by the position history used to detect stuck controllers, which is also how fast they are detected."));
+
+	float GMoveOscillationRatio = 0.2f;
+	FAutoConsoleVariableRef CVarMoveOscillationRatio(
+		TEXT("UDCore.Move.OscillationRatio"),
+		GMoveOscillationRatio,
+		TEXT("Controllers whose progress along their path is below this fraction of the distance they travelled over the position history are considered stuck."));
+
+	int32 GMoveMaxStuckRepaths = 1;
+	FAutoConsoleVariableRef CVarMoveMaxStuckRepaths(
+		TEXT("UDCore.Move.MaxStuckRepaths"),
+		GMoveMaxStuckRepaths,
+		TEXT("The number of times a stuck controller finds a new path before its move request fails."));
+
+	float GMoveLowFidelityDistance = 0.0f;
+	FAutoConsoleVariableRef CVarMoveLowFidelityDistance(
+		TEXT("UDCore.Move.LowFidelityDistance"),
+		GMoveLowFidelityDistance,
+		TEXT("Controllers further than this distance from every player viewpoint, and not recently rendered, move at low fidelity along their path corridor. 0 disables low fidelity movement."));
+
+	float GMoveLowFidelityCheckIntervalScale = 4.0f;
+	FAutoConsoleVariableRef CVarMoveLowFidelityCheckIntervalScale(
+		TEXT("UDCore.Move.LowFidelityCheckIntervalScale"),
+		GMoveLowFidelityCheckIntervalScale,
+		TEXT("The multiplier applied to the check interval of move requests moving at low fidelity."));
+
+	float GMoveSignificanceInterval = 0.5f;
+	FAutoConsoleVariableRef CVarMoveSignificanceInterval(
+		TEXT("UDCore.Move.SignificanceInterval"),
+		GMoveSignificanceInterval,
+		TEXT("The interval in seconds between two updates of the fidelity of the move requests."));
+
+	/** The number of move requests checked together, the frame budget is tested between batches. */
+	constexpr int32 MoveCheckBatchSize = 64;
+
+	enum class EMoveCheckResult : uint8
+	{
+		Moving,
+		Arrived,
+		Stuck,
+		Lost,
+	};
+
+	/** Returns the path following component of the controller, if it has one. */
+	UPathFollowingComponent* FindPathFollowingComponent(const AController& Controller)
+	{
+		if (const AAIController* AIController = Cast<AAIController>(&Controller))
+		{
+			return AIController->GetPathFollowingComponent();
+		}
+		return Controller.FindComponentByClass<UPathFollowingComponent>();
+	}
+
+	/**
+	 * Returns the path following component of the controller.
+	 * Player controllers do not have one by default, it is created the same way SimpleMoveToLocation does.
+	 */
+	UPathFollowingComponent* GetOrCreatePathFollowingComponent(AController& Controller)
+	{
+		UPathFollowingComponent* PathFollowingComponent = FindPathFollowingComponent(Controller);
+		if (!PathFollowingComponent && !Controller.IsA<AAIController>())
+		{
+			PathFollowingComponent = NewObject<UPathFollowingComponent>(&Controller);
+			PathFollowingComponent->RegisterComponentWithWorld(Controller.GetWorld());
+			PathFollowingComponent->Initialize();
+		}
+		return PathFollowingComponent;
+	}
+
+	/** Returns the length of the path left to follow, or the straight distance to the destination if the controller is not following a path. */
+	float GetRemainingPathDistance(const AController& Controller, const FVector& Location, const FVector& Destination)
+	{
+		const UPathFollowingComponent* PathFollowingComponent = FindPathFollowingComponent(Controller);
+		const FNavPathSharedPtr Path = PathFollowingComponent ? PathFollowingComponent->GetPath() : nullptr;
+		if (Path.IsValid() && Path->IsValid() && PathFollowingComponent->GetStatus() == EPathFollowingStatus::Moving)
+		{
+			return Path->GetLengthFromPosition(Location, PathFollowingComponent->GetNextPathIndex());
+		}
+		return FVector::Dist(Location, Destination);
+	}
+}
+
+void UUDCoreMoveSubsystem::FMoveHistory::Add(const FVector& Location, const float RemainingDistance)
+{
+	Locations[Head] = Location;
+	RemainingDistances[Head] = RemainingDistance;
+	Head = (Head + 1) % NumSamples;
+	Num = FMath::Min(Num + 1, NumSamples);
+}
+
+bool UUDCoreMoveSubsystem::FMoveHistory::IsStuck(const float StuckThreshold, const float OscillationRatio) const
+{
+	if (Num < NumSamples) { return false; }
+
+	// Once the buffer is full the head is the oldest sample.
+	const int32 Newest = (Head + NumSamples - 1) % NumSamples;
+	const double Progress = RemainingDistances[Head] - RemainingDistances[Newest];
+	if (Progress < StuckThreshold)
+	{
+		// Standing still, sliding along a wall or moving back and forth in place.
+		return true;
+	}
+
+	double TravelledDistance = 0.0;
+	for (int32 Sample = 1; Sample < NumSamples; ++Sample)
+	{
+		TravelledDistance += FVector::Dist(Locations[(Head + Sample - 1) % NumSamples], Locations[(Head + Sample) % NumSamples]);
+	}
+
+	// Moving a lot while making little progress along the path, such as circling around an obstacle.
+	// Switchbacks and hairpin turns progress along the path as much as the agent travels, so they are not mistaken for it.
+	return Progress < TravelledDistance * OscillationRatio;
+}
+
+FUDMoveRequestHandle UUDCoreMoveSubsystem::RequestMove(
+	AController* Controller,
+	const FUDMoveRequestParams& Params,
+	FOnUDMoveRequestCompleted&& OnCompleted)
+{
+	if (!Controller || !Controller->GetPawn())
+	{
+		return FUDMoveRequestHandle();
+	}
+
+	FUDMoveRequestParams RequestParams = Params;
+	if (const AActor* TargetActor = Params.TargetActor.Get())
+	{
+		RequestParams.Destination = TargetActor->GetActorLocation();
+	}
+
+	const FUDMoveRequestHandle Handle = AddMoveRequest(*Controller, RequestParams, MoveTemp(OnCompleted));
+	if (Params.bUseAsyncPathfinding)
+	{
+		QueuePathQuery(Handle);
+	}
+	else
+	{
+		const int32 Index = HandleToIndex.FindChecked(Handle);
+		UAIBlueprintHelperLibrary::SimpleMoveToLocation(Controller, Destinations[Index]);
+
+		// The helper finds and follows the path on its own, read its length back for the telemetry.
+		const UPathFollowingComponent* PathFollowingComponent = FindPathFollowingComponent(*Controller);
+		const FNavPathSharedPtr Path = PathFollowingComponent ? PathFollowingComponent->GetPath() : nullptr;
+		Telemetry[Index].PathLength = Path.IsValid() ? Path->GetLength() : 0.0f;
+	}
+
+	return Handle;
+}
+
+TArray<FUDMoveRequestHandle> UUDCoreMoveSubsystem::RequestGroupMove(
+	const TArray<AController*>& GroupControllers,
+	const FUDMoveRequestParams& Params,
+	const float FormationSpacing,
+	const float MaxSharedPathDistance,
+	const FOnUDMoveRequestCompleted& OnCompleted)
+{
+	TArray<FUDMoveRequestHandle> GroupHandles;
+	GroupHandles.SetNum(GroupControllers.Num());
+
+	TArray<int32, TInlineAllocator<64>> Members;
+	FVector Centroid = FVector::ZeroVector;
+	for (int32 Member = 0; Member < GroupControllers.Num(); ++Member)
+	{
+		const AController* Controller = GroupControllers[Member];
+		if (!Controller || !Controller->GetPawn()) { continue; }
+
+		Members.Add(Member);
+		Centroid += Controller->GetPawn()->GetActorLocation();
+	}
+	if (Members.Num() == 0) { return GroupHandles; }
+	Centroid /= Members.Num();
+
+	// The member closest to the middle of the group finds the path shared by everyone.
+	int32 Leader = Members[0];
+	double LeaderDistanceSquared = TNumericLimits<double>::Max();
+	for (const int32 Member : Members)
+	{
+		const double DistanceSquared = FVector::DistSquared(GroupControllers[Member]->GetPawn()->GetActorLocation(), Centroid);
+		if (DistanceSquared < LeaderDistanceSquared)
+		{
+			Leader = Member;
+			LeaderDistanceSquared = DistanceSquared;
+		}
+	}
+
+	// Every member waits for the shared path before it starts moving.
+	AController* LeaderController = GroupControllers[Leader];
+	const APawn* LeaderPawn = LeaderController->GetPawn();
+	FGroupMove GroupMove;
+	GroupMove.Destination = Params.Destination;
+	GroupMove.LeaderLocation = LeaderPawn->GetNavAgentLocation();
+	GroupMove.FormationSpacing = FormationSpacing;
+	GroupMove.MaxSharedPathDistance = MaxSharedPathDistance;
+	for (const int32 Member : Members)
+	{
+		const FUDMoveRequestHandle Handle = AddMoveRequest(*GroupControllers[Member], Params, FOnUDMoveRequestCompleted(OnCompleted));
+		AwaitingPaths[HandleToIndex.FindChecked(Handle)] = true;
+		GroupHandles[Member] = Handle;
+		GroupMove.Members.Add(Handle);
+	}
+
+	UNavigationSystemV1* NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const FNavAgentProperties& AgentProperties = LeaderController->GetNavAgentPropertiesRef();
+	const ANavigationData* NavigationData = NavigationSystem
+		? NavigationSystem->GetNavDataForProps(AgentProperties, LeaderPawn->GetActorLocation())
+		: nullptr;
+
+	UE_LOG(LogUDCore, Verbose, TEXT("Group of %i controllers moving to location (%s)."), Members.Num(), *Params.Destination.ToString());
+
+	if (!NavigationData)
+	{
+		AssignGroupPaths(GroupMove, nullptr);
+		return GroupHandles;
+	}
+
+	GroupMove.NavigationData = NavigationData;
+	GroupMove.QueryFilter = UNavigationQueryFilter::GetQueryFilter(*NavigationData, LeaderController, nullptr);
+	FPathFindingQuery Query(LeaderController, *NavigationData, GroupMove.LeaderLocation, Params.Destination, GroupMove.QueryFilter);
+	Query.SetAllowPartialPaths(true);
+
+	if (Params.bUseAsyncPathfinding)
+	{
+		const uint32 QueryId = NavigationSystem->FindPathAsync(
+			AgentProperties,
+			Query,
+			FNavPathQueryDelegate::CreateUObject(this, &UUDCoreMoveSubsystem::OnGroupPathQueryFinished));
+		GroupPathQueries.Add(QueryId, MoveTemp(GroupMove));
+		INC_DWORD_STAT(STAT_UDCoreAsyncPathQueries);
+	}
+	else
+	{
+		const FPathFindingResult Result = NavigationSystem->FindPathSync(AgentProperties, Query);
+		AssignGroupPaths(GroupMove, Result.IsSuccessful() ? Result.Path : nullptr);
+	}
+
+	return GroupHandles;
+}
+
+void UUDCoreMoveSubsystem::AssignGroupPaths(const FGroupMove& GroupMove, FNavPathSharedPtr SharedPath)
+{
+	if (SharedPath.IsValid() && (!SharedPath->IsValid() || SharedPath->GetPathPoints().Num() < 2))
+	{
+		SharedPath.Reset();
+	}
+
+	// Members cancelled or destroyed while the shared path was being found are left out.
+	TArray<int32, TInlineAllocator<64>> Indices;
+	for (const FUDMoveRequestHandle Handle : GroupMove.Members)
+	{
+		const int32* Index = HandleToIndex.Find(Handle);
+		if (!Index) { continue; }
+
+		const AController* Controller = Controllers[*Index].Get();
+		if (Controller && Controller->GetPawn())
+		{
+			Indices.Add(*Index);
+		}
+		else
+		{
+			// The query finds the pawn missing and fails the request.
+			QueuePathQuery(Handle);
+		}
+	}
+	if (Indices.Num() == 0) { return; }
+
+	UNavigationSystemV1* NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavigationData = NavigationSystem ? GroupMove.NavigationData.Get() : nullptr;
+	if (!NavigationData)
+	{
+		SharedPath.Reset();
+	}
+
+	// Lay the formation slots out in rows behind the destination, facing the end of the path.
+	const FVector LastPathDirection = SharedPath.IsValid()
+		? GroupMove.Destination - SharedPath->GetPathPoints().Last(1).Location
+		: GroupMove.Destination - GroupMove.LeaderLocation;
+	const FVector Forward = LastPathDirection.GetSafeNormal2D().IsNearlyZero() ? FVector::ForwardVector : LastPathDirection.GetSafeNormal2D();
+	const FVector Right(-Forward.Y, Forward.X, 0.0);
+	const int32 NumColumns = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Indices.Num())));
+	const float FormationSpacing = GroupMove.FormationSpacing;
+
+	// The members closest to the destination take the front slots so the paths do not cross.
+	Indices.Sort([this, &GroupMove](const int32 A, const int32 B)
+	{
+		return FVector::DistSquared(Controllers[A]->GetPawn()->GetActorLocation(), GroupMove.Destination)
+			< FVector::DistSquared(Controllers[B]->GetPawn()->GetActorLocation(), GroupMove.Destination);
+	});
+
+	for (int32 Slot = 0; Slot < Indices.Num(); ++Slot)
+	{
+		const int32 Index = Indices[Slot];
+		const int32 Row = Slot / NumColumns;
+		const int32 Column = Slot % NumColumns;
+		const FVector SlotOffset = Right * ((Column - (NumColumns - 1) * 0.5f) * FormationSpacing) - Forward * (Row * FormationSpacing);
+
+		Destinations[Index] = GroupMove.Destination + SlotOffset;
+		if (NavigationData)
+		{
+			FNavLocation ProjectedSlot;
+			if (NavigationSystem->ProjectPointToNavigation(Destinations[Index], ProjectedSlot, FVector(FormationSpacing, FormationSpacing, 250.0f), NavigationData))
+			{
+				Destinations[Index] = ProjectedSlot.Location;
+			}
+			else
+			{
+				Destinations[Index] = GroupMove.Destination;
+			}
+		}
+
+		// Members close enough to the leader follow the shared path, ending at their own slot.
+		const FVector MemberLocation = Controllers[Index]->GetPawn()->GetNavAgentLocation();
+		bool bFollowingSharedPath = false;
+		if (SharedPath.IsValid() && FVector::DistSquared(MemberLocation, GroupMove.LeaderLocation) <= FMath::Square(GroupMove.MaxSharedPathDistance))
+		{
+			const TArray<FNavPathPoint>& SharedPoints = SharedPath->GetPathPoints();
+			TArray<FVector> MemberPoints;
+			MemberPoints.Reserve(SharedPoints.Num());
+			MemberPoints.Add(MemberLocation);
+			for (int32 Point = 1; Point < SharedPoints.Num() - 1; ++Point)
+			{
+				MemberPoints.Add(SharedPoints[Point].Location);
+			}
+			MemberPoints.Add(Destinations[Index]);
+
+			// Only the interior points come from the query, the segments joining the member to them must be clear on the navmesh.
+			FVector HitLocation;
+			const bool bJoinBlocked = NavigationData->Raycast(MemberPoints[0], MemberPoints[1], HitLocation, GroupMove.QueryFilter, Controllers[Index].Get())
+				|| (MemberPoints.Num() > 2 && NavigationData->Raycast(MemberPoints.Last(1), MemberPoints.Last(), HitLocation, GroupMove.QueryFilter, Controllers[Index].Get()));
+			if (!bJoinBlocked)
+			{
+				bFollowingSharedPath = FollowPath(Index, MakeShared<FNavigationPath, ESPMode::ThreadSafe>(MemberPoints));
+			}
+		}
+
+		// Members that cannot use the shared path find their own, without blocking the game thread.
+		if (!bFollowingSharedPath)
+		{
+			QueuePathQuery(Handles[Index]);
+		}
+	}
+}
+
+void UUDCoreMoveSubsystem::OnGroupPathQueryFinished(const uint32 QueryId, const ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+{
+	FGroupMove GroupMove;
+	if (!GroupPathQueries.RemoveAndCopyValue(QueryId, GroupMove)) { return; }
+
+	AssignGroupPaths(GroupMove, Result == ENavigationQueryResult::Success ? Path : nullptr);
+}
+
+FUDMoveRequestHandle UUDCoreMoveSubsystem::AddMoveRequest(
+	AController& Controller,
+	const FUDMoveRequestParams& Params,
+	FOnUDMoveRequestCompleted&& OnCompleted)
+{
+	const FUDMoveRequestHandle Handle(NextRequestId++);
+	if (NextRequestId == 0) { NextRequestId = 1; }
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	HandleToIndex.Add(Handle, Handles.Num());
+	Handles.Add(Handle);
+	Controllers.Add(&Controller);
+	Destinations.Add(Params.Destination);
+	LastCheckedLocations.Add(Controller.GetPawn()->GetActorLocation());
+	AcceptanceRadii.Add(Params.AcceptanceRadius);
+	StuckThresholds.Add(Params.StuckThreshold);
+	NextCheckTimes.Add(CurrentTime + GMoveMinCheckInterval);
+	NextStuckSampleTimes.Add(Params.bCheckStuckMovement ? CurrentTime : TNumericLimits<double>::Max());
+	Histories.AddDefaulted();
+	RepathCounts.Add(0);
+	Telemetry.AddDefaulted_GetRef().StartTime = CurrentTime;
+	AwaitingPaths.Add(false);
+	FollowTargetKeys.Add(Params.TargetActor.IsValid() ? FObjectKey(Params.TargetActor.Get()) : FObjectKey());
+	RepathDistancesSquared.Add(FMath::Square(Params.RepathDistance));
+	LowFidelityMoves.AddDefaulted_GetRef().bAllowed = Params.bAllowLowFidelity && !Params.TargetActor.IsValid();
+	CompletedDelegates.Add(MoveTemp(OnCompleted));
+
+	if (AActor* TargetActor = Params.TargetActor.Get())
+	{
+		FFollowTarget* FollowTarget = FollowTargets.Find(FollowTargetKeys.Last());
+		if (!FollowTarget)
+		{
+			FollowTarget = &FollowTargets.Add(FollowTargetKeys.Last());
+			FollowTarget->Actor = TargetActor;
+			FollowTarget->Goal = Params.Destination;
+			FollowTarget->GoalActorLocation = Params.Destination;
+		}
+		FollowTarget->Followers.Add(Handle);
+
+		// Join the other followers at the goal their paths end at.
+		Destinations.Last() = FollowTarget->Goal;
+	}
+
+	return Handle;
+}
+
+void UUDCoreMoveSubsystem::QueuePathQuery(const FUDMoveRequestHandle Handle)
+{
+	AwaitingPaths[HandleToIndex.FindChecked(Handle)] = true;
+	QueuedPathQueries.Add(Handle);
+}
+
+bool UUDCoreMoveSubsystem::FollowPath(const int32 Index, const FNavPathSharedPtr& Path)
+{
+	AController* Controller = Controllers[Index].Get();
+	const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+	UPathFollowingComponent* PathFollowingComponent = Pawn ? GetOrCreatePathFollowingComponent(*Controller) : nullptr;
+	if (!PathFollowingComponent) { return false; }
+
+	FAIMoveRequest MoveRequest(Destinations[Index]);
+	MoveRequest.SetAcceptanceRadius(AcceptanceRadii[Index]);
+	MoveRequest.SetAllowPartialPath(true);
+	if (!PathFollowingComponent->RequestMove(MoveRequest, Path).IsValid()) { return false; }
+
+	// Start the arrival and stuck checks now that the controller is actually moving.
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	AwaitingPaths[Index] = false;
+	LastCheckedLocations[Index] = Pawn->GetActorLocation();
+	NextCheckTimes[Index] = CurrentTime + GMoveMinCheckInterval;
+	Histories[Index].Reset();
+	Telemetry[Index].PathLength = Path->GetLength();
+	if (NextStuckSampleTimes[Index] != TNumericLimits<double>::Max())
+	{
+		NextStuckSampleTimes[Index] = CurrentTime;
+	}
+	return true;
+}
+
+bool UUDCoreMoveSubsystem::CancelMove(const FUDMoveRequestHandle Handle)
+{
+	const int32* Index = HandleToIndex.Find(Handle);
+	if (!Index) { return false; }
+
+	RemoveMoveRequestAt(*Index);
+	return true;
+}
+
+const FUDMoveRequestTelemetry* UUDCoreMoveSubsystem::GetMoveTelemetry(const FUDMoveRequestHandle Handle) const
+{
+	const int32* Index = HandleToIndex.Find(Handle);
+	return Index ? &Telemetry[*Index] : nullptr;
+}
+
+FUDMoveRequestHandle UUDCoreMoveSubsystem::FindMoveRequest(const AController* Controller) const
+{
+	for (int32 Index = 0; Index < Controllers.Num(); ++Index)
+	{
+		if (Controllers[Index].Get() == Controller) { return Handles[Index]; }
+	}
+	return FUDMoveRequestHandle();
+}
+
+bool UUDCoreMoveSubsystem::GetMoveDestination(const FUDMoveRequestHandle Handle, FVector& OutDestination, float& OutAcceptanceRadius) const
+{
+	const int32* Index = HandleToIndex.Find(Handle);
+	if (!Index) { return false; }
+
+	OutDestination = Destinations[*Index];
+	OutAcceptanceRadius = AcceptanceRadii[*Index];
+	return true;
+}
+
+void UUDCoreMoveSubsystem::Deinitialize()
+{
+	// The world is going away along with the controllers, the pending requests are dropped without completing.
+	Handles.Empty();
+	Controllers.Empty();
+	Destinations.Empty();
+	LastCheckedLocations.Empty();
+	AcceptanceRadii.Empty();
+	StuckThresholds.Empty();
+	NextCheckTimes.Empty();
+	NextStuckSampleTimes.Empty();
+	Histories.Empty();
+	RepathCounts.Empty();
+	Telemetry.Empty();
+	AwaitingPaths.Empty();
+	CompletedDelegates.Empty();
+	HandleToIndex.Empty();
+	QueuedPathQueries.Empty();
+	PathQueries.Empty();
+	FollowTargetKeys.Empty();
+	RepathDistancesSquared.Empty();
+	LowFidelityMoves.Empty();
+	NumLowFidelityMoves = 0;
+	FollowTargets.Empty();
+	GroupPathQueries.Empty();
+	ExtensionQueries.Empty();
+
+	Super::Deinitialize();
+}
+
+void UUDCoreMoveSubsystem::Tick(const float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UDCoreCheckMoveRequests);
+	SET_DWORD_STAT(STAT_UDCoreActiveMoveRequests, Handles.Num());
+
+	LastFrameStats = FUDMoveSchedulerStats();
+	DispatchPathQueries();
+
+	const int32 NumRequests = Handles.Num();
+	if (NumRequests == 0) { return; }
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	UpdateSignificance(CurrentTime);
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	const uint64 BudgetCycles = GMoveFrameBudgetUs > 0.0f
+		? static_cast<uint64>(GMoveFrameBudgetUs / (FPlatformTime::GetSecondsPerCycle64() * 1000000.0))
+		: MAX_uint64;
+
+	TArray<int32, TInlineAllocator<MoveCheckBatchSize>> Batch;
+	TArray<TPair<FUDMoveRequestHandle, bool>> CompletedRequests;
+	bool bOverBudget = false;
+
+	// Start where the last frame ran out of budget so no request is starved.
+	int32 Index = ScanCursor < NumRequests ? ScanCursor : 0;
+	for (int32 NumScanned = 0; NumScanned < NumRequests; ++NumScanned)
+	{
+		if (NextCheckTimes[Index] <= CurrentTime && !AwaitingPaths[Index])
+		{
+			if (bOverBudget)
+			{
+				++LastFrameStats.NumDeferred;
+			}
+			else
+			{
+				Batch.Add(Index);
+				if (Batch.Num() == MoveCheckBatchSize)
+				{
+					CheckMoveRequests(Batch, CurrentTime, CompletedRequests);
+					Batch.Reset();
+
+					if (FPlatformTime::Cycles64() - StartCycles >= BudgetCycles)
+					{
+						bOverBudget = true;
+						ScanCursor = Index + 1;
+					}
+				}
+			}
+		}
+		Index = Index + 1 < NumRequests ? Index + 1 : 0;
+	}
+
+	if (Batch.Num() > 0)
+	{
+		CheckMoveRequests(Batch, CurrentTime, CompletedRequests);
+	}
+
+	RepathFollowTargets();
+
+	// Remove the completed requests before notifying anyone, the delegates may issue new requests.
+	TArray<TTuple<FUDMoveRequestHandle, bool, FOnUDMoveRequestCompleted>, TInlineAllocator<16>> CompletedDelegatesToExecute;
+	for (const TPair<FUDMoveRequestHandle, bool>& CompletedRequest : CompletedRequests)
+	{
+		const int32 CompletedIndex = HandleToIndex.FindChecked(CompletedRequest.Key);
+		TraceMoveCompleted(CompletedIndex, CompletedRequest.Value);
+		CompletedDelegatesToExecute.Emplace(CompletedRequest.Key, CompletedRequest.Value, MoveTemp(CompletedDelegates[CompletedIndex]));
+		RemoveMoveRequestAt(CompletedIndex);
+	}
+
+	TRACE_COUNTER_SET(UDCoreActiveMoveRequests, Handles.Num());
+	TRACE_COUNTER_SET(UDCoreMoveChecks, LastFrameStats.NumChecks);
+	LastFrameStats.ElapsedMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+	INC_DWORD_STAT_BY(STAT_UDCoreMoveChecks, LastFrameStats.NumChecks);
+	INC_DWORD_STAT_BY(STAT_UDCoreDeferredMoveChecks, LastFrameStats.NumDeferred);
+
+	for (TTuple<FUDMoveRequestHandle, bool, FOnUDMoveRequestCompleted>& CompletedRequest : CompletedDelegatesToExecute)
+	{
+		CompletedRequest.Get<2>().ExecuteIfBound(CompletedRequest.Get<0>(), CompletedRequest.Get<1>());
+	}
+}
+
+bool UUDCoreMoveSubsystem::IsTickable() const
+{
+	return Handles.Num() > 0;
+}
+
+TStatId UUDCoreMoveSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UUDCoreMoveSubsystem, STATGROUP_Tickables);
+}
+
+bool UUDCoreMoveSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UUDCoreMoveSubsystem::CheckMoveRequests(
+	const TConstArrayView<int32> Indices,
+	const double CurrentTime,
+	TArray<TPair<FUDMoveRequestHandle, bool>>& OutCompleted)
+{
+	const int32 NumChecks = Indices.Num();
+	LastFrameStats.NumChecks += NumChecks;
+
+	TArray<EMoveCheckResult, TInlineAllocator<MoveCheckBatchSize>> Results;
+	Results.Init(EMoveCheckResult::Moving, NumChecks);
+	TArray<double, TInlineAllocator<MoveCheckBatchSize>> DistancesSquared;
+	DistancesSquared.SetNumUninitialized(NumChecks);
+	TArray<FVector, TInlineAllocator<MoveCheckBatchSize>> ArrivalLocations;
+	ArrivalLocations.SetNumUninitialized(NumChecks);
+
+	// Gather the pawn locations and speeds first so the checks below run over contiguous memory.
+	CurrentLocations.SetNumUninitialized(NumChecks);
+	CurrentSpeeds.SetNumUninitialized(NumChecks);
+	for (int32 Check = 0; Check < NumChecks; ++Check)
+	{
+		const int32 Index = Indices[Check];
+		const AController* Controller = Controllers[Index].Get();
+		const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+		if (!Pawn)
+		{
+			Results[Check] = EMoveCheckResult::Lost;
+			CurrentLocations[Check] = LastCheckedLocations[Index];
+			CurrentSpeeds[Check] = 0.0f;
+			continue;
+		}
+
+		// The velocity of a pawn moving at low fidelity is reset, it moves at the corridor speed instead.
+		const FLowFidelityMove& LowFidelityMove = LowFidelityMoves[Index];
+		if (LowFidelityMove.IsActive())
+		{
+			StepLowFidelity(Index, CurrentTime);
+		}
+		CurrentLocations[Check] = Pawn->GetActorLocation();
+		CurrentSpeeds[Check] = LowFidelityMove.IsActive() ? LowFidelityMove.Speed : Pawn->GetVelocity().Size();
+	}
+
+	// Followers arrive at their target rather than at the end of their path, and flag the targets that moved too far from it.
+	// Their destination stays on the goal so that their own repaths keep ending where the extensions start.
+	for (int32 Check = 0; Check < NumChecks; ++Check)
+	{
+		const int32 Index = Indices[Check];
+		ArrivalLocations[Check] = Destinations[Index];
+		FFollowTarget* FollowTarget = FollowTargetKeys[Index] != FObjectKey() ? FollowTargets.Find(FollowTargetKeys[Index]) : nullptr;
+		if (!FollowTarget || Results[Check] != EMoveCheckResult::Moving) { continue; }
+
+		const AActor* TargetActor = FollowTarget->Actor.Get();
+		if (!TargetActor)
+		{
+			Results[Check] = EMoveCheckResult::Lost;
+			continue;
+		}
+
+		ArrivalLocations[Check] = TargetActor->GetActorLocation();
+		if (FVector::DistSquared(ArrivalLocations[Check], FollowTarget->Goal) > RepathDistancesSquared[Index])
+		{
+			FollowTarget->bNeedsRepath = true;
+			continue;
+		}
+
+		// A target that moved less than the repath distance, but out of the acceptance radius of the goal, is never reached
+		// by following the path to the goal. Repath once the follower is done with its path. Targets that did not move
+		// since the goal was found are not reachable any closer, so they do not repath.
+		const UPathFollowingComponent* PathFollowingComponent = FindPathFollowingComponent(*Controllers[Index].Get());
+		const bool bReachedPathEnd = !PathFollowingComponent || PathFollowingComponent->GetStatus() == EPathFollowingStatus::Idle;
+		const float AcceptanceRadiusSquared = FMath::Square(AcceptanceRadii[Index]);
+		if (bReachedPathEnd
+			&& FVector::DistSquared(CurrentLocations[Check], ArrivalLocations[Check]) >= AcceptanceRadiusSquared
+			&& FVector::DistSquared(ArrivalLocations[Check], FollowTarget->GoalActorLocation) >= AcceptanceRadiusSquared)
+		{
+			FollowTarget->bNeedsRepath = true;
+		}
+	}
+
+	for (int32 Check = 0; Check < NumChecks; ++Check)
+	{
+		const int32 Index = Indices[Check];
+		DistancesSquared[Check] = FVector::DistSquared(CurrentLocations[Check], ArrivalLocations[Check]);
+		if (DistancesSquared[Check] < FMath::Square(AcceptanceRadii[Index]) && Results[Check] == EMoveCheckResult::Moving)
+		{
+			Results[Check] = EMoveCheckResult::Arrived;
+		}
+	}
+
+	for (int32 Check = 0; Check < NumChecks; ++Check)
+	{
+		const int32 Index = Indices[Check];
+		if (Results[Check] != EMoveCheckResult::Moving) { continue; }
+
+		// Low fidelity moves cannot get stuck, they go back to full fidelity with a new path if their corridor ends short of the destination.
+		const FLowFidelityMove& LowFidelityMove = LowFidelityMoves[Index];
+		if (LowFidelityMove.IsActive())
+		{
+			if (LowFidelityMove.NextPoint >= LowFidelityMove.Corridor->GetPathPoints().Num())
+			{
+				ExitLowFidelity(Index, true);
+			}
+			continue;
+		}
+
+		if (CurrentTime < NextStuckSampleTimes[Index]) { continue; }
+
+		NextStuckSampleTimes[Index] = CurrentTime + FMath::Max(GMoveStuckDetectionLatency, 0.0f) / (FMoveHistory::NumSamples - 1);
+		FMoveHistory& History = Histories[Index];
+		History.Add(
+			CurrentLocations[Check],
+			GetRemainingPathDistance(*Controllers[Index].Get(), CurrentLocations[Check], Destinations[Index]));
+
+		if (!History.IsStuck(StuckThresholds[Index], GMoveOscillationRatio)) { continue; }
+
+		History.Reset();
+		++Telemetry[Index].NumStuckEvents;
+		const bool bRepathing = RepathCounts[Index] < GMoveMaxStuckRepaths;
+		UE_TRACE_LOG(UDCoreMove, MoveStuck, UDCoreMoveChannel)
+			<< MoveStuck.Cycle(FPlatformTime::Cycles64())
+			<< MoveStuck.RequestId(Handles[Index].Id)
+			<< MoveStuck.LocationX(CurrentLocations[Check].X)
+			<< MoveStuck.LocationY(CurrentLocations[Check].Y)
+			<< MoveStuck.LocationZ(CurrentLocations[Check].Z)
+			<< MoveStuck.bRepathing(bRepathing);
+
+		if (bRepathing)
+		{
+			// Find a new path from where the controller is stuck, the checks resume once it follows it.
+			UE_LOG(LogUDCore, Verbose, TEXT("Controller is stuck while moving to location. Finding a new path."));
+			++RepathCounts[Index];
+			++Telemetry[Index].NumRepaths;
+			AwaitingPaths[Index] = true;
+			QueuedPathQueries.Add(Handles[Index]);
+			continue;
+		}
+
+		Results[Check] = EMoveCheckResult::Stuck;
+	}
+
+	// Check again around half of the time the agent needs to reach the acceptance radius at its current speed.
+	for (int32 Check = 0; Check < NumChecks; ++Check)
+	{
+		const int32 Index = Indices[Check];
+		Telemetry[Index].TravelledDistance += FVector::Dist(LastCheckedLocations[Index], CurrentLocations[Check]);
+		LastCheckedLocations[Index] = CurrentLocations[Check];
+
+		const double RemainingDistance = FMath::Max(FMath::Sqrt(DistancesSquared[Check]) - AcceptanceRadii[Index], 0.0);
+		const double TimeToArrive = RemainingDistance / FMath::Max(CurrentSpeeds[Check], UE_KINDA_SMALL_NUMBER);
+		const double IntervalScale = LowFidelityMoves[Index].IsActive() ? FMath::Max(GMoveLowFidelityCheckIntervalScale, 1.0f) : 1.0;
+		NextCheckTimes[Index] = CurrentTime + IntervalScale * FMath::Clamp(TimeToArrive * 0.5, static_cast<double>(GMoveMinCheckInterval), static_cast<double>(GMoveMaxCheckInterval));
+
+		// Stuck samples are only taken on checks. Agents that stopped progressing are checked at the sampling rate so they
+		// are detected within the stuck detection latency, agents making progress keep their adaptive interval.
+		const bool bStalling = Histories[Index].GetLastProgress() < StuckThresholds[Index] / (FMoveHistory::NumSamples - 1);
+		if (bStalling && NextStuckSampleTimes[Index] != TNumericLimits<double>::Max() && !LowFidelityMoves[Index].IsActive())
+		{
+			NextCheckTimes[Index] = FMath::Min(NextCheckTimes[Index], NextStuckSampleTimes[Index]);
+		}
+	}
+
+	for (int32 Check = 0; Check < NumChecks; ++Check)
+	{
+		if (Results[Check] == EMoveCheckResult::Moving) { continue; }
+
+		if (Results[Check] == EMoveCheckResult::Lost)
+		{
+			UE_LOG(LogUDCore, Warning, TEXT("Controller, pawn or target actor has been destroyed while moving to location. Aborting."));
+		}
+		else if (Results[Check] == EMoveCheckResult::Stuck)
+		{
+			UE_LOG(LogUDCore, Warning, TEXT("Controller is stuck while moving to location. Aborting"));
+		}
+		else
+		{
+			UE_LOG(LogUDCore, Verbose, TEXT("Controller has moved to location."));
+		}
+
+		OutCompleted.Emplace(Handles[Indices[Check]], Results[Check] == EMoveCheckResult::Arrived);
+	}
+}
+
+void UUDCoreMoveSubsystem::UpdateSignificance(const double CurrentTime)
+{
+	if (CurrentTime < NextSignificanceTime || (GMoveLowFidelityDistance <= 0.0f && NumLowFidelityMoves == 0)) { return; }
+	NextSignificanceTime = CurrentTime + GMoveSignificanceInterval;
+
+	TArray<FVector, TInlineAllocator<4>> ViewLocations;
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		if (const APlayerController* PlayerController = Iterator->Get())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewLocations.Add(ViewLocation);
+		}
+	}
+
+	const bool bLowFidelityEnabled = GMoveLowFidelityDistance > 0.0f;
+	const double LowFidelityDistanceSquared = FMath::Square(GMoveLowFidelityDistance);
+	for (int32 Index = 0; Index < Handles.Num(); ++Index)
+	{
+		const FLowFidelityMove& LowFidelityMove = LowFidelityMoves[Index];
+		const AController* Controller = Controllers[Index].Get();
+		const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+		if (!LowFidelityMove.bAllowed || AwaitingPaths[Index] || !Pawn) { continue; }
+
+		// Dedicated servers render nothing, so only the distance to the players counts there.
+		bool bSignificant = !bLowFidelityEnabled || Pawn->WasRecentlyRendered(GMoveSignificanceInterval);
+		const FVector PawnLocation = Pawn->GetActorLocation();
+		for (int32 View = 0; View < ViewLocations.Num() && !bSignificant; ++View)
+		{
+			bSignificant = FVector::DistSquared(PawnLocation, ViewLocations[View]) < LowFidelityDistanceSquared;
+		}
+
+		if (bSignificant && LowFidelityMove.IsActive())
+		{
+			ExitLowFidelity(Index, true);
+		}
+		else if (!bSignificant && !LowFidelityMove.IsActive())
+		{
+			EnterLowFidelity(Index, CurrentTime);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_UDCoreLowFidelityMoveRequests, NumLowFidelityMoves);
+}
+
+void UUDCoreMoveSubsystem::EnterLowFidelity(const int32 Index, const double CurrentTime)
+{
+	const AController* Controller = Controllers[Index].Get();
+	APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+	UPathFollowingComponent* PathFollowingComponent = Pawn ? FindPathFollowingComponent(*Controller) : nullptr;
+	const FNavPathSharedPtr Path = PathFollowingComponent ? PathFollowingComponent->GetPath() : nullptr;
+	if (!Path.IsValid() || !Path->IsValid() || PathFollowingComponent->GetStatus() != EPathFollowingStatus::Moving) { return; }
+
+	UPawnMovementComponent* MovementComponent = Pawn->GetMovementComponent();
+	FLowFidelityMove& LowFidelityMove = LowFidelityMoves[Index];
+	LowFidelityMove.Corridor = Path;
+	LowFidelityMove.NextPoint = FMath::Max(PathFollowingComponent->GetNextPathIndex(), 1);
+	LowFidelityMove.LastStepTime = CurrentTime;
+	LowFidelityMove.Speed = MovementComponent ? MovementComponent->GetMaxSpeed() : Pawn->GetVelocity().Size();
+	LowFidelityMove.HeightOffset = Pawn->GetActorLocation().Z - Pawn->GetNavAgentLocation().Z;
+	++NumLowFidelityMoves;
+
+	PathFollowingComponent->PauseMove();
+	if (MovementComponent)
+	{
+		MovementComponent->SetComponentTickEnabled(false);
+	}
+}
+
+void UUDCoreMoveSubsystem::ExitLowFidelity(const int32 Index, const bool bRepath)
+{
+	FLowFidelityMove& LowFidelityMove = LowFidelityMoves[Index];
+	if (!LowFidelityMove.IsActive()) { return; }
+
+	LowFidelityMove.Corridor.Reset();
+	--NumLowFidelityMoves;
+
+	AController* Controller = Controllers[Index].Get();
+	const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+	if (!Pawn) { return; }
+
+	if (UPawnMovementComponent* MovementComponent = Pawn->GetMovementComponent())
+	{
+		MovementComponent->SetComponentTickEnabled(true);
+	}
+
+	// The paused move cannot be resumed, its current segment is behind the pawn. The new path replaces it.
+	if (bRepath)
+	{
+		QueuePathQuery(Handles[Index]);
+	}
+	else if (UPathFollowingComponent* PathFollowingComponent = FindPathFollowingComponent(*Controller))
+	{
+		PathFollowingComponent->AbortMove(*this, FPathFollowingResultFlags::MovementStop);
+	}
+}
+
+bool UUDCoreMoveSubsystem::StepLowFidelity(const int32 Index, const double CurrentTime)
+{
+	FLowFidelityMove& LowFidelityMove = LowFidelityMoves[Index];
+	APawn* Pawn = Controllers[Index]->GetPawn();
+	const TArray<FNavPathPoint>& CorridorPoints = LowFidelityMove.Corridor->GetPathPoints();
+
+	double RemainingDistance = LowFidelityMove.Speed * (CurrentTime - LowFidelityMove.LastStepTime);
+	LowFidelityMove.LastStepTime = CurrentTime;
+
+	const FVector StartLocation = Pawn->GetNavAgentLocation();
+	FVector Location = StartLocation;
+	while (RemainingDistance > 0.0 && LowFidelityMove.NextPoint < CorridorPoints.Num())
+	{
+		const FVector ToNextPoint = CorridorPoints[LowFidelityMove.NextPoint].Location - Location;
+		const double DistanceToNextPoint = ToNextPoint.Size();
+		if (DistanceToNextPoint > RemainingDistance)
+		{
+			Location += ToNextPoint * (RemainingDistance / DistanceToNextPoint);
+			break;
+		}
+
+		Location = CorridorPoints[LowFidelityMove.NextPoint].Location;
+		RemainingDistance -= DistanceToNextPoint;
+		++LowFidelityMove.NextPoint;
+	}
+
+	const FVector Direction = (Location - StartLocation).GetSafeNormal2D();
+	Pawn->SetActorLocationAndRotation(
+		Location + FVector(0.0f, 0.0f, LowFidelityMove.HeightOffset),
+		Direction.IsNearlyZero() ? Pawn->GetActorRotation() : Direction.Rotation(),
+		false,
+		nullptr,
+		ETeleportType::TeleportPhysics);
+
+	return LowFidelityMove.NextPoint < CorridorPoints.Num();
+}
+
+void UUDCoreMoveSubsystem::DispatchPathQueries()
+{
+	if (QueuedPathQueries.Num() == 0) { return; }
+
+	UNavigationSystemV1* NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const int32 MaxQueries = GMoveMaxPathQueriesPerFrame > 0 ? GMoveMaxPathQueriesPerFrame : QueuedPathQueries.Num();
+
+	int32 NumSent = 0;
+	int32 NumConsumed = 0;
+	TArray<FUDMoveRequestHandle, TInlineAllocator<16>> FailedRequests;
+	for (; NumConsumed < QueuedPathQueries.Num() && NumSent < MaxQueries; ++NumConsumed)
+	{
+		const FUDMoveRequestHandle Handle = QueuedPathQueries[NumConsumed];
+		const int32* Index = HandleToIndex.Find(Handle);
+		if (!Index) { continue; }
+
+		AController* Controller = Controllers[*Index].Get();
+		const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+		const FNavAgentProperties& AgentProperties = Controller ? Controller->GetNavAgentPropertiesRef() : FNavAgentProperties::DefaultProperties;
+		const ANavigationData* NavigationData = NavigationSystem && Pawn
+			? NavigationSystem->GetNavDataForProps(AgentProperties, Pawn->GetActorLocation())
+			: nullptr;
+		if (!NavigationData)
+		{
+			FailedRequests.Add(Handle);
+			continue;
+		}
+
+		FPathFindingQuery Query(
+			Controller,
+			*NavigationData,
+			Pawn->GetNavAgentLocation(),
+			Destinations[*Index],
+			UNavigationQueryFilter::GetQueryFilter(*NavigationData, Controller, nullptr));
+		Query.SetAllowPartialPaths(true);
+
+		const uint32 QueryId = NavigationSystem->FindPathAsync(
+			AgentProperties,
+			Query,
+			FNavPathQueryDelegate::CreateUObject(this, &UUDCoreMoveSubsystem::OnPathQueryFinished));
+		PathQueries.Add(QueryId, Handle);
+		++NumSent;
+	}
+
+	QueuedPathQueries.RemoveAt(0, NumConsumed, UDCore::NoShrink);
+	INC_DWORD_STAT_BY(STAT_UDCoreAsyncPathQueries, NumSent);
+
+	for (const FUDMoveRequestHandle Handle : FailedRequests)
+	{
+		UE_LOG(LogUDCore, Warning, TEXT("No navigation data found to move the controller to location. Aborting."));
+		FinishMoveRequest(Handle, false);
+	}
+}
+
+void UUDCoreMoveSubsystem::OnPathQueryFinished(const uint32 QueryId, const ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+{
+	FUDMoveRequestHandle Handle;
+	if (!PathQueries.RemoveAndCopyValue(QueryId, Handle)) { return; }
+
+	// The request may have been cancelled while the query was in flight.
+	const int32* Index = HandleToIndex.Find(Handle);
+	if (!Index) { return; }
+
+	if (Result != ENavigationQueryResult::Success || !Path.IsValid())
+	{
+		UE_LOG(LogUDCore, Warning, TEXT("Failed to find a path to move the controller to location. Aborting."));
+		FinishMoveRequest(Handle, false);
+		return;
+	}
+
+	if (!FollowPath(*Index, Path))
+	{
+		UE_LOG(LogUDCore, Warning, TEXT("Failed to follow the path to location. Aborting."));
+		FinishMoveRequest(Handle, false);
+	}
+}
+
+void UUDCoreMoveSubsystem::RepathFollowTargets()
+{
+	UNavigationSystemV1* NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	for (TPair<FObjectKey, FFollowTarget>& FollowTargetPair : FollowTargets)
+	{
+		FFollowTarget& FollowTarget = FollowTargetPair.Value;
+		if (!FollowTarget.bNeedsRepath || FollowTarget.ExtensionQueryId != 0) { continue; }
+		FollowTarget.bNeedsRepath = false;
+
+		// The query uses the agent properties and filter of the first follower that can still move.
+		const AActor* TargetActor = FollowTarget.Actor.Get();
+		AController* Controller = nullptr;
+		for (const FUDMoveRequestHandle Follower : FollowTarget.Followers)
+		{
+			Controller = Controllers[HandleToIndex.FindChecked(Follower)].Get();
+			if (Controller && Controller->GetPawn()) { break; }
+			Controller = nullptr;
+		}
+		if (!TargetActor || !Controller || !NavigationSystem) { continue; }
+
+		const FNavAgentProperties& AgentProperties = Controller->GetNavAgentPropertiesRef();
+		const ANavigationData* NavigationData = NavigationSystem->GetNavDataForProps(AgentProperties, FollowTarget.Goal);
+		if (!NavigationData) { continue; }
+
+		FollowTarget.ExtensionActorLocation = TargetActor->GetActorLocation();
+		FPathFindingQuery Query(
+			Controller,
+			*NavigationData,
+			FollowTarget.Goal,
+			FollowTarget.ExtensionActorLocation,
+			UNavigationQueryFilter::GetQueryFilter(*NavigationData, Controller, nullptr));
+		Query.SetAllowPartialPaths(true);
+
+		FollowTarget.ExtensionQueryId = NavigationSystem->FindPathAsync(
+			AgentProperties,
+			Query,
+			FNavPathQueryDelegate::CreateUObject(this, &UUDCoreMoveSubsystem::OnExtensionQueryFinished));
+		ExtensionQueries.Add(FollowTarget.ExtensionQueryId, FollowTargetPair.Key);
+		INC_DWORD_STAT(STAT_UDCoreAsyncPathQueries);
+	}
+}
+
+void UUDCoreMoveSubsystem::OnExtensionQueryFinished(const uint32 QueryId, const ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+{
+	FObjectKey TargetKey;
+	if (!ExtensionQueries.RemoveAndCopyValue(QueryId, TargetKey)) { return; }
+
+	// Every follower may have completed while the query was in flight.
+	FFollowTarget* FollowTarget = FollowTargets.Find(TargetKey);
+	if (!FollowTarget || FollowTarget->ExtensionQueryId != QueryId) { return; }
+	FollowTarget->ExtensionQueryId = 0;
+
+	const bool bExtensionFound = Result == ENavigationQueryResult::Success && Path.IsValid() && Path->GetPathPoints().Num() > 1;
+	const FVector PreviousGoal = FollowTarget->Goal;
+	FollowTarget->Goal = bExtensionFound ? Path->GetEndLocation() : FollowTarget->Actor.IsValid() ? FollowTarget->Actor->GetActorLocation() : PreviousGoal;
+	FollowTarget->GoalActorLocation = bExtensionFound ? FollowTarget->ExtensionActorLocation : FollowTarget->Goal;
+
+	for (const FUDMoveRequestHandle Follower : FollowTarget->Followers)
+	{
+		const int32* Index = HandleToIndex.Find(Follower);
+		if (!Index) { continue; }
+
+		// Stuck and fallback repaths go to the destination, keep it on the goal the next extension starts from.
+		Destinations[*Index] = FollowTarget->Goal;
+		if (AwaitingPaths[*Index]) { continue; }
+
+		++Telemetry[*Index].NumRepaths;
+		if (!bExtensionFound || !SpliceFollowPath(*Index, PreviousGoal, Path))
+		{
+			QueuePathQuery(Follower);
+		}
+	}
+}
+
+bool UUDCoreMoveSubsystem::SpliceFollowPath(const int32 Index, const FVector& PreviousGoal, const FNavPathSharedPtr& Extension)
+{
+	const AController* Controller = Controllers[Index].Get();
+	const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+	const UPathFollowingComponent* PathFollowingComponent = Pawn ? FindPathFollowingComponent(*Controller) : nullptr;
+	const FNavPathSharedPtr CurrentPath = PathFollowingComponent ? PathFollowingComponent->GetPath() : nullptr;
+	if (!CurrentPath.IsValid() || !CurrentPath->IsValid() || PathFollowingComponent->GetStatus() != EPathFollowingStatus::Moving)
+	{
+		return false;
+	}
+
+	// Going to the previous goal first is a detour when the target came back towards the follower.
+	const FVector PawnLocation = Pawn->GetNavAgentLocation();
+	const FVector NewGoal = Extension->GetEndLocation();
+	if (FVector::DistSquared(PawnLocation, NewGoal) < FVector::DistSquared(PawnLocation, PreviousGoal))
+	{
+		return false;
+	}
+
+	// The extension starts at the previous goal, so the current path must end there. The last point of the current path is replaced
+	// by the first point of the extension, the segment joining them must be clear on the navmesh.
+	const TArray<FNavPathPoint>& CurrentPoints = CurrentPath->GetPathPoints();
+	const TArray<FNavPathPoint>& ExtensionPoints = Extension->GetPathPoints();
+	if (FVector::DistSquared(CurrentPoints.Last().Location, PreviousGoal) > FMath::Square(AcceptanceRadii[Index]))
+	{
+		return false;
+	}
+
+	const int32 FirstPoint = FMath::Max(PathFollowingComponent->GetNextPathIndex(), 1);
+	const FVector JoinStart = FirstPoint < CurrentPoints.Num() - 1 ? CurrentPoints.Last(1).Location : PawnLocation;
+	const ANavigationData* NavigationData = Extension->GetNavigationDataUsed();
+	FVector HitLocation;
+	if (!NavigationData || NavigationData->Raycast(JoinStart, ExtensionPoints[0].Location, HitLocation, Extension->GetQueryFilter(), Controller))
+	{
+		return false;
+	}
+
+	TArray<FVector> SplicedPoints;
+	SplicedPoints.Reserve(CurrentPoints.Num() + ExtensionPoints.Num());
+	SplicedPoints.Add(PawnLocation);
+	for (int32 Point = FirstPoint; Point < CurrentPoints.Num() - 1; ++Point)
+	{
+		SplicedPoints.Add(CurrentPoints[Point].Location);
+	}
+	for (const FNavPathPoint& ExtensionPoint : ExtensionPoints)
+	{
+		SplicedPoints.Add(ExtensionPoint.Location);
+	}
+
+	return FollowPath(Index, MakeShared<FNavigationPath, ESPMode::ThreadSafe>(SplicedPoints));
+}
+
+void UUDCoreMoveSubsystem::TraceMoveCompleted(const int32 Index, const bool bSuccess) const
+{
+	const FUDMoveRequestTelemetry& RequestTelemetry = Telemetry[Index];
+	UE_TRACE_LOG(UDCoreMove, MoveCompleted, UDCoreMoveChannel)
+		<< MoveCompleted.Cycle(FPlatformTime::Cycles64())
+		<< MoveCompleted.RequestId(Handles[Index].Id)
+		<< MoveCompleted.bSuccess(bSuccess)
+		<< MoveCompleted.TimeToArrival(GetWorld()->GetTimeSeconds() - RequestTelemetry.StartTime)
+		<< MoveCompleted.PathLength(RequestTelemetry.PathLength)
+		<< MoveCompleted.TravelledDistance(RequestTelemetry.TravelledDistance)
+		<< MoveCompleted.NumRepaths(RequestTelemetry.NumRepaths)
+		<< MoveCompleted.NumStuckEvents(RequestTelemetry.NumStuckEvents);
+}
+
+void UUDCoreMoveSubsystem::FinishMoveRequest(const FUDMoveRequestHandle Handle, const bool bSuccess)
+{
+	const int32* Index = HandleToIndex.Find(Handle);
+	if (!Index) { return; }
+
+	TraceMoveCompleted(*Index, bSuccess);
+	FOnUDMoveRequestCompleted OnCompleted = MoveTemp(CompletedDelegates[*Index]);
+	RemoveMoveRequestAt(*Index);
+	OnCompleted.ExecuteIfBound(Handle, bSuccess);
+}
+
+void UUDCoreMoveSubsystem::RemoveMoveRequestAt(const int32 Index)
+{
+	ExitLowFidelity(Index, false);
+
+	if (FFollowTarget* FollowTarget = FollowTargets.Find(FollowTargetKeys[Index]))
+	{
+		FollowTarget->Followers.RemoveSingleSwap(Handles[Index], UDCore::NoShrink);
+		if (FollowTarget->Followers.Num() == 0)
+		{
+			// A pending extension query finds no target and is ignored.
+			FollowTargets.Remove(FollowTargetKeys[Index]);
+		}
+	}
+
+	HandleToIndex.Remove(Handles[Index]);
+
+	const int32 LastIndex = Handles.Num() - 1;
+	if (Index != LastIndex)
+	{
+		HandleToIndex[Handles[LastIndex]] = Index;
+	}
+
+	Handles.RemoveAtSwap(Index, 1, UDCore::NoShrink);
+	Controllers.RemoveAtSwap(Index, 1, UDCore::NoShrink);
+	Destinations.RemoveAtSwap(Index, 1, UDCore::NoShrink);
+	LastCheckedLocations.RemoveAtSwap(Index, 1, UDCore::NoShrink);
+	AcceptanceRadii.RemoveAtSwap(Index, 1, UDCore::NoShrink);
+	StuckThresholds.RemoveAtSwap(Index, 1, UDCore::NoShrink);
+	NextCheckTimes.RemoveAtSwap(Index, 1, UDCore::NoShrink);
+	NextStuckSampleTimes.RemoveAtSwap(Index, 1, UDCore::NoShrink);
+	Histories.RemoveAtSwap(Index, 1, UDCore::NoShrink);
+	RepathCounts.RemoveAtSwap(Index, 1, UDCore::NoShrink);
+	Telemetry.RemoveAtSwap(Index, 1, UDCore::NoShrink);
+	AwaitingPaths.RemoveAtSwap(Index, 1, UDCore::NoShrink);
+	FollowTargetKeys.RemoveAtSwap(Index, 1, UDCore::NoShrink);
+	RepathDistancesSquared.RemoveAtSwap(Index, 1, UDCore::NoShrink);
+	LowFidelityMoves.RemoveAtSwap(Index, 1, UDCore::NoShrink);
+	CompletedDelegates.RemoveAtSwap(Index, 1, UDCore::NoShrink);
+}
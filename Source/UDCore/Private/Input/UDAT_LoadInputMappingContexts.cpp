@@ -0,0 +1,176 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+
+#include "Input/UDAT_LoadInputMappingContexts.h"
+#include "Libraries/UDCoreInputFunctionLibrary.h"
+#include "UDCoreLogChannels.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "GameFramework/Controller.h"
+#include "InputMappingContext.h"
+
+UUDAT_LoadInputMappingContexts* UUDAT_LoadInputMappingContexts::AddInputMappingContextsAsync(
+	AController* PlayerController,
+	const TArray<FUDCoreEnhancedInputContextData>& Contexts,
+	const bool bClearPrevious)
+{
+	UUDAT_LoadInputMappingContexts* Action = NewObject<UUDAT_LoadInputMappingContexts>();
+	Action->Operation = EOperation::Add;
+	Action->PlayerController = PlayerController;
+	Action->Contexts = Contexts;
+	Action->bClearPrevious = bClearPrevious;
+	Action->RegisterWithGameInstance(PlayerController);
+
+	return Action;
+}
+
+UUDAT_LoadInputMappingContexts* UUDAT_LoadInputMappingContexts::RemoveInputMappingContextsAsync(
+	AController* PlayerController,
+	const TArray<TSoftObjectPtr<UInputMappingContext>>& Contexts)
+{
+	UUDAT_LoadInputMappingContexts* Action = NewObject<UUDAT_LoadInputMappingContexts>();
+	Action->Operation = EOperation::Remove;
+	Action->PlayerController = PlayerController;
+	Action->Contexts.Reserve(Contexts.Num());
+	for (const TSoftObjectPtr<UInputMappingContext>& Context : Contexts)
+	{
+		Action->Contexts.AddDefaulted_GetRef().InputContext = Context;
+	}
+	Action->RegisterWithGameInstance(PlayerController);
+
+	return Action;
+}
+
+UUDAT_LoadInputMappingContexts* UUDAT_LoadInputMappingContexts::SwapInputMappingContextsAsync(
+	AController* PlayerController,
+	const TSoftObjectPtr<UInputMappingContext> PreviousContext,
+	const TSoftObjectPtr<UInputMappingContext> NewContext,
+	const int32 Priority,
+	const bool bUsePreviousPriority)
+{
+	UUDAT_LoadInputMappingContexts* Action = NewObject<UUDAT_LoadInputMappingContexts>();
+	Action->Operation = EOperation::Swap;
+	Action->PlayerController = PlayerController;
+	Action->Contexts.AddDefaulted_GetRef().InputContext = PreviousContext;
+
+	FUDCoreEnhancedInputContextData& NewContextData = Action->Contexts.AddDefaulted_GetRef();
+	NewContextData.InputContext = NewContext;
+	NewContextData.Priority = Priority;
+
+	Action->bUsePreviousPriority = bUsePreviousPriority;
+	Action->RegisterWithGameInstance(PlayerController);
+
+	return Action;
+}
+
+void UUDAT_LoadInputMappingContexts::Activate()
+{
+	// A context that is not loaded cannot be applied, so there is nothing to load for a removal.
+	if (Operation == EOperation::Remove)
+	{
+		ApplyContexts();
+		return;
+	}
+
+	TArray<FSoftObjectPath> PathsToLoad;
+	PathsToLoad.Reserve(Contexts.Num());
+	for (const FUDCoreEnhancedInputContextData& Context : Contexts)
+	{
+		if (!Context.InputContext.IsNull() && !Context.InputContext.IsValid())
+		{
+			PathsToLoad.AddUnique(Context.InputContext.ToSoftObjectPath());
+		}
+	}
+
+	if (PathsToLoad.IsEmpty())
+	{
+		ApplyContexts();
+		return;
+	}
+
+	UE_LOG(LogUDCore, Verbose, TEXT("Loading %i input mapping contexts asynchronously."), PathsToLoad.Num());
+
+	LoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MoveTemp(PathsToLoad),
+		FStreamableDelegate::CreateUObject(this, &UUDAT_LoadInputMappingContexts::OnContextsLoaded),
+		FStreamableManager::AsyncLoadHighPriority);
+
+	if (!LoadHandle.IsValid())
+	{
+		ApplyContexts();
+	}
+}
+
+void UUDAT_LoadInputMappingContexts::OnContextsLoaded()
+{
+	ApplyContexts();
+}
+
+void UUDAT_LoadInputMappingContexts::ApplyContexts()
+{
+	// The contexts are loaded at this point, so the library functions find them without loading anything.
+	AController* Controller = PlayerController.Get();
+	if (!Controller)
+	{
+		UE_LOG(LogUDCore, Warning, TEXT("PlayerController has been destroyed while loading input mapping contexts. Aborting."));
+		ExecuteCompleted(false);
+		return;
+	}
+
+	EUDSuccessStatus Status = EUDSuccessStatus::Failure;
+	switch (Operation)
+	{
+	case EOperation::Add:
+		Status = UUDCoreInputFunctionLibrary::AddInputMappingContexts(Controller, Contexts, bClearPrevious);
+		break;
+	case EOperation::Remove:
+		{
+			TArray<TSoftObjectPtr<UInputMappingContext>> ContextsToRemove;
+			ContextsToRemove.Reserve(Contexts.Num());
+			for (const FUDCoreEnhancedInputContextData& Context : Contexts)
+			{
+				if (Context.InputContext.IsValid())
+				{
+					ContextsToRemove.Add(Context.InputContext);
+				}
+			}
+
+			if (ContextsToRemove.IsEmpty())
+			{
+				UE_LOG(LogUDCore, Verbose, TEXT("None of the %i input mapping contexts to remove are loaded, so none of them are applied."), Contexts.Num());
+				Status = EUDSuccessStatus::Success;
+			}
+			else
+			{
+				Status = UUDCoreInputFunctionLibrary::RemoveInputMappingContexts(Controller, ContextsToRemove);
+			}
+		}
+		break;
+	case EOperation::Swap:
+		Status = UUDCoreInputFunctionLibrary::SwapInputMappingContexts(
+			Controller,
+			Contexts[0].InputContext,
+			Contexts[1].InputContext,
+			Contexts[1].Priority,
+			bUsePreviousPriority);
+		break;
+	}
+
+	ExecuteCompleted(Status == EUDSuccessStatus::Success);
+}
+
+void UUDAT_LoadInputMappingContexts::ExecuteCompleted(const bool bSuccess)
+{
+	Completed.Broadcast(bSuccess);
+
+	if (LoadHandle.IsValid())
+	{
+		LoadHandle->ReleaseHandle();
+		LoadHandle.Reset();
+	}
+
+	PlayerController.Reset();
+	Contexts.Empty();
+
+	SetReadyToDestroy();
+}
@@ -0,0 +1,143 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+
+#include "Input/UDCoreInputLatencyProbe.h"
+#include "UDCoreLogChannels.h"
+#include "EnhancedInputSubsystems.h"
+#include "EnhancedPlayerInput.h"
+#include "InputMappingContext.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+TRACE_DECLARE_FLOAT_COUNTER(UDCoreInputLatencyMs, TEXT("UDCore/Input/Latency (ms)"));
+
+namespace
+{
+	/** Presses that have not triggered any action after this many seconds are dropped. */
+	constexpr double MaxPendingPressSeconds = 1.0;
+
+	TSharedPtr<FUDCoreInputLatencyProbe> GInputLatencyProbe;
+
+	bool GInputLatencyProbeEnabled = false;
+	FAutoConsoleVariableRef CVarInputLatencyProbe(
+		TEXT("UDCore.Input.LatencyProbe"),
+		GInputLatencyProbeEnabled,
+		TEXT("Trace the time from a key press to the Enhanced Input action mapped to it triggering, in the UDCore/Input/Latency (ms) counter."),
+		FConsoleVariableDelegate::CreateLambda([](IConsoleVariable*)
+		{
+			FUDCoreInputLatencyProbe::SetEnabled(GInputLatencyProbeEnabled);
+		}));
+}
+
+void FUDCoreInputLatencyProbe::SetEnabled(const bool bEnabled)
+{
+	if (!FSlateApplication::IsInitialized()) { return; }
+
+	if (bEnabled && !GInputLatencyProbe.IsValid())
+	{
+		GInputLatencyProbe = MakeShared<FUDCoreInputLatencyProbe>();
+		FSlateApplication::Get().RegisterInputPreProcessor(GInputLatencyProbe);
+	}
+	else if (!bEnabled && GInputLatencyProbe.IsValid())
+	{
+		FSlateApplication::Get().UnregisterInputPreProcessor(GInputLatencyProbe);
+		GInputLatencyProbe.Reset();
+	}
+}
+
+bool FUDCoreInputLatencyProbe::HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent)
+{
+	if (!InKeyEvent.IsRepeat())
+	{
+		RecordPress(InKeyEvent.GetKey());
+	}
+	return false;
+}
+
+bool FUDCoreInputLatencyProbe::HandleMouseButtonDownEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent)
+{
+	RecordPress(MouseEvent.GetEffectingButton());
+	return false;
+}
+
+void FUDCoreInputLatencyProbe::RecordPress(const FKey& Key)
+{
+	FPendingPress& PendingPress = PendingPresses.Add(Key);
+	PendingPress.Time = FPlatformTime::Seconds();
+
+	// Actions that are already triggering, such as through another held key, did not transition because of this press.
+	ForEachMappedAction([&Key, &PendingPress](const FEnhancedActionKeyMapping& Mapping, const FInputActionInstance& ActionInstance)
+	{
+		if (Mapping.Key == Key && IsTriggering(ActionInstance))
+		{
+			PendingPress.TriggeringActions.AddUnique(Mapping.Action.Get());
+		}
+	});
+}
+
+void FUDCoreInputLatencyProbe::Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor)
+{
+	// Slate ticks after the world, so the actions triggered by this frame's presses have been processed already.
+	if (PendingPresses.IsEmpty()) { return; }
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	ForEachMappedAction([this, CurrentTime](const FEnhancedActionKeyMapping& Mapping, const FInputActionInstance& ActionInstance)
+	{
+		const FPendingPress* PendingPress = PendingPresses.Find(Mapping.Key);
+		if (!PendingPress || !IsTriggering(ActionInstance) || PendingPress->TriggeringActions.Contains(Mapping.Action.Get())) { return; }
+
+		const double LatencyMs = (CurrentTime - PendingPress->Time) * 1000.0;
+		TRACE_COUNTER_SET(UDCoreInputLatencyMs, LatencyMs);
+		UE_LOG(LogUDCore, VeryVerbose, TEXT("%s triggered %s after %.2fms."), *Mapping.Key.ToString(), *GetNameSafe(Mapping.Action), LatencyMs);
+		PendingPresses.Remove(Mapping.Key);
+	});
+
+	for (auto Iterator = PendingPresses.CreateIterator(); Iterator; ++Iterator)
+	{
+		if (CurrentTime - Iterator.Value().Time > MaxPendingPressSeconds)
+		{
+			Iterator.RemoveCurrent();
+		}
+	}
+}
+
+bool FUDCoreInputLatencyProbe::IsTriggering(const FInputActionInstance& ActionInstance)
+{
+	const ETriggerEvent TriggerEvent = ActionInstance.GetTriggerEvent();
+	return TriggerEvent == ETriggerEvent::Started || TriggerEvent == ETriggerEvent::Triggered;
+}
+
+void FUDCoreInputLatencyProbe::ForEachMappedAction(const TFunctionRef<void(const FEnhancedActionKeyMapping&, const FInputActionInstance&)> Function)
+{
+	if (!GEngine) { return; }
+
+	for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+	{
+		const UGameInstance* GameInstance = WorldContext.OwningGameInstance;
+		if (!GameInstance || !WorldContext.World() || !WorldContext.World()->IsGameWorld()) { continue; }
+
+		for (const ULocalPlayer* LocalPlayer : GameInstance->GetLocalPlayers())
+		{
+			const UEnhancedInputLocalPlayerSubsystem* EnhancedInput = LocalPlayer ? LocalPlayer->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>() : nullptr;
+			const UEnhancedPlayerInput* PlayerInput = EnhancedInput ? EnhancedInput->GetPlayerInput() : nullptr;
+			if (!PlayerInput) { continue; }
+
+			for (const TPair<TObjectPtr<const UInputMappingContext>, int32>& AppliedContext : PlayerInput->GetAppliedInputContexts())
+			{
+				if (!AppliedContext.Key) { continue; }
+
+				for (const FEnhancedActionKeyMapping& Mapping : AppliedContext.Key->GetMappings())
+				{
+					if (const FInputActionInstance* ActionInstance = PlayerInput->FindActionInstanceData(Mapping.Action))
+					{
+						Function(Mapping, *ActionInstance);
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,54 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Framework/Application/IInputProcessor.h"
+#include "InputCoreTypes.h"
+
+class UInputAction;
+struct FEnhancedActionKeyMapping;
+struct FInputActionInstance;
+
+/**
+ * Measures the time from a key or mouse button press reaching Slate to an Enhanced Input action mapped to it triggering,
+ * and reports it to the UDCore/Input/Latency (ms) trace counter.
+ * Only actions that start triggering after the press are counted, so actions held by another key are not measured.
+ * Enabled with the UDCore.Input.LatencyProbe console variable.
+ */
+class FUDCoreInputLatencyProbe : public IInputProcessor
+{
+public:
+
+	/** Registers or unregisters the probe with Slate. */
+	static void SetEnabled(bool bEnabled);
+
+	// IInputProcessor
+	virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override;
+	virtual bool HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override;
+	virtual bool HandleMouseButtonDownEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override;
+	virtual const TCHAR* GetDebugName() const override { return TEXT("UDCoreInputLatencyProbe"); }
+
+private:
+
+	struct FPendingPress
+	{
+		/** The time the key was pressed at. */
+		double Time = 0.0;
+
+		/** The actions mapped to the key that were already triggering when it was pressed. */
+		TArray<const UInputAction*, TInlineAllocator<4>> TriggeringActions;
+	};
+
+	/** Starts measuring a press of the key, recording the actions mapped to it that are already triggering. */
+	void RecordPress(const FKey& Key);
+
+	/** Returns true if the action started or is triggering. */
+	static bool IsTriggering(const FInputActionInstance& ActionInstance);
+
+	/** Calls the function for every mapping of the applied contexts of every local player in a game world whose action has instance data. */
+	static void ForEachMappedAction(TFunctionRef<void(const FEnhancedActionKeyMapping&, const FInputActionInstance&)> Function);
+
+	/** The presses of each key, until an action mapped to it starts triggering. */
+	TMap<FKey, FPendingPress> PendingPresses;
+};
@@ -0,0 +1,38 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+
+#include "Input/UDCoreInputModeData.h"
+#include "UDCoreLogChannels.h"
+#include "InputMappingContext.h"
+
+void UUDCoreInputModeData::ResolveContexts()
+{
+	if (bContextsResolved) { return; }
+	bContextsResolved = true;
+
+	ResolvedContexts.Reset(Contexts.Num());
+	ResolvedPriorities.Reset(Contexts.Num());
+	for (const FUDCoreEnhancedInputContextData& Context : Contexts)
+	{
+		if (const UInputMappingContext* MappingContext = Context.InputContext.LoadSynchronous())
+		{
+			ResolvedContexts.Add(MappingContext);
+			ResolvedPriorities.Add(Context.Priority);
+		}
+		else
+		{
+			UE_LOG(LogUDCore, Warning, TEXT("Input mapping context %s of input mode %s failed to load."), *Context.InputContext.ToString(), *GetName());
+		}
+	}
+}
+
+#if WITH_EDITOR
+void UUDCoreInputModeData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	bContextsResolved = false;
+	ResolvedContexts.Reset();
+	ResolvedPriorities.Reset();
+}
+#endif
@@ -3,12 +3,107 @@
 
 #include "Libraries/UDCoreInputFunctionLibrary.h"
 #include "EnhancedInputSubsystems.h"
+#include "EnhancedPlayerInput.h"
 #include "InputMappingContext.h"
 #include "UDCoreLogChannels.h"
+#include "UDCoreStats.h"
 #include "Logging/StructuredLog.h"
 #include "GameFramework/Controller.h"
 #include "GameFramework/PlayerController.h"
 #include "Engine/LocalPlayer.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_CYCLE_STAT(TEXT("Load Input Mapping Context"), STAT_UDCoreLoadInputMappingContext, STATGROUP_UDCore);
+DECLARE_CYCLE_STAT(TEXT("Rebuild Control Mappings"), STAT_UDCoreRebuildControlMappings, STATGROUP_UDCore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Input Mapping Contexts Changed"), STAT_UDCoreInputMappingContextsChanged, STATGROUP_UDCore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Input Mappings Affected"), STAT_UDCoreInputMappingsAffected, STATGROUP_UDCore);
+
+TRACE_DECLARE_INT_COUNTER(UDCoreInputMappingContextsChanged, TEXT("UDCore/Input/Contexts Changed"));
+TRACE_DECLARE_INT_COUNTER(UDCoreInputMappingsAffected, TEXT("UDCore/Input/Mappings Affected"));
+TRACE_DECLARE_FLOAT_COUNTER(UDCoreInputContextLoadMs, TEXT("UDCore/Input/Context Load (ms)"));
+TRACE_DECLARE_FLOAT_COUNTER(UDCoreInputRebuildMs, TEXT("UDCore/Input/Rebuild Control Mappings (ms)"));
+
+namespace
+{
+	bool GInputMeasureRebuilds = false;
+	FAutoConsoleVariableRef CVarInputMeasureRebuilds(
+		TEXT("UDCore.Input.MeasureRebuilds"),
+		GInputMeasureRebuilds,
+		TEXT("Rebuild the control mappings right after UDCore changes input mapping contexts instead of at the end of the frame, so the rebuild time is traced."));
+
+	/** Returns the loaded context, loading it synchronously and tracing the load time if it is not loaded yet. */
+	const UInputMappingContext* LoadInputMappingContext(const TSoftObjectPtr<UInputMappingContext>& Context)
+	{
+		if (const UInputMappingContext* LoadedContext = Context.Get()) { return LoadedContext; }
+		if (Context.IsNull()) { return nullptr; }
+
+		TRACE_CPUPROFILER_EVENT_SCOPE(UDCoreInput_LoadInputMappingContext);
+		SCOPE_CYCLE_COUNTER(STAT_UDCoreLoadInputMappingContext);
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		const UInputMappingContext* LoadedContext = Context.LoadSynchronous();
+		const double LoadMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+		TRACE_COUNTER_SET(UDCoreInputContextLoadMs, LoadMs);
+
+		UE_LOG(LogUDCore, Verbose, TEXT("Input mapping context %s loaded synchronously in %.2fms."), *Context.ToString(), LoadMs);
+		return LoadedContext;
+	}
+
+	/** Returns the number of key mappings of the context. */
+	int32 GetNumMappings(const UInputMappingContext* Context)
+	{
+		return Context ? Context->GetMappings().Num() : 0;
+	}
+
+	/** Records a batch of context changes, and rebuilds the control mappings in a traced scope if UDCore.Input.MeasureRebuilds is set. */
+	void RecordContextChanges(UEnhancedInputLocalPlayerSubsystem& EnhancedInput, const int32 NumContexts, const int32 NumMappings)
+	{
+		TRACE_COUNTER_SET(UDCoreInputMappingContextsChanged, NumContexts);
+		TRACE_COUNTER_SET(UDCoreInputMappingsAffected, NumMappings);
+		INC_DWORD_STAT_BY(STAT_UDCoreInputMappingContextsChanged, NumContexts);
+		INC_DWORD_STAT_BY(STAT_UDCoreInputMappingsAffected, NumMappings);
+
+		if (!GInputMeasureRebuilds || NumContexts == 0) { return; }
+
+		TRACE_CPUPROFILER_EVENT_SCOPE(UDCoreInput_RebuildControlMappings);
+		SCOPE_CYCLE_COUNTER(STAT_UDCoreRebuildControlMappings);
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+
+		FModifyContextOptions Options;
+		Options.bForceImmediately = true;
+		EnhancedInput.RequestRebuildControlMappings(Options);
+		TRACE_COUNTER_SET(UDCoreInputRebuildMs, FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+	}
+
+	/**
+	 * Returns the player controller the controller acts for. A player controller acts for itself, any other controller
+	 * for the player controller owning its pawn, or owning the controller itself.
+	 */
+	const APlayerController* ResolvePlayerController(const AController* Controller)
+	{
+		if (const APlayerController* PlayerController = Cast<APlayerController>(Controller)) { return PlayerController; }
+		if (!Controller) { return nullptr; }
+
+		const AActor* OwnedActors[] = { Controller->GetPawn(), Controller };
+		for (const AActor* OwnedActor : OwnedActors)
+		{
+			for (const AActor* Owner = OwnedActor ? OwnedActor->GetOwner() : nullptr; Owner; Owner = Owner->GetOwner())
+			{
+				if (const APlayerController* PlayerController = Cast<APlayerController>(Owner)) { return PlayerController; }
+			}
+		}
+
+		return nullptr;
+	}
+}
+
+UEnhancedInputLocalPlayerSubsystem* UUDCoreInputFunctionLibrary::FindEnhancedInputSubsystem(const AController* Controller)
+{
+	const APlayerController* PlayerController = ResolvePlayerController(Controller);
+	const ULocalPlayer* LocalPlayer = PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
+	return LocalPlayer ? LocalPlayer->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>() : nullptr;
+}
 
 bool UUDCoreInputFunctionLibrary::TryGetEnhancedInputSubsystemFromController(
 	AController* PlayerController,
@@ -20,22 +115,24 @@ bool UUDCoreInputFunctionLibrary::TryGetEnhancedInputSubsystemFromController(
 		return false;
 	}
 
-	const ULocalPlayer* LocalPlayer = Cast<APlayerController>(PlayerController)->GetLocalPlayer();
-	if (!LocalPlayer)
+	EnhancedInput = FindEnhancedInputSubsystem(PlayerController);
+	if (EnhancedInput) { return true; }
+
+	const APlayerController* CastPlayerController = ResolvePlayerController(PlayerController);
+	if (!CastPlayerController)
+	{
+		UE_LOG(LogUDCore, Warning, TEXT("%s is not a player controller and its pawn is not owned by one. Cannot set input mapping contexts."), *PlayerController->GetName());
+	}
+	else if (!CastPlayerController->GetLocalPlayer())
 	{
 		UE_LOG(LogUDCore, Warning, TEXT("LocalPlayer not found. Cannot set input mapping contexts."));
-		return false;
 	}
-
-	EnhancedInput = LocalPlayer->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>();
-
-	if(!EnhancedInput)
+	else
 	{
-		UE_LOG(LogUDCore, Warning, TEXT("EnhancedInput subsystem not found. Cannot remove input mapping contexts."));
-		return false;
+		UE_LOG(LogUDCore, Warning, TEXT("EnhancedInput subsystem not found. Cannot set input mapping contexts."));
 	}
-	
-	return true;
+
+	return false;
 }
 
 EUDSuccessStatus UUDCoreInputFunctionLibrary::AddInputMappingContexts(
@@ -43,6 +140,7 @@ EUDSuccessStatus UUDCoreInputFunctionLibrary::AddInputMappingContexts(
 	const TArray<FUDCoreEnhancedInputContextData>& Contexts,
 	const bool bClearPrevious)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(UDCoreInput_AddInputMappingContexts);
 	if (Contexts.IsEmpty()) { return EUDSuccessStatus::Failure; }
 	
 	UEnhancedInputLocalPlayerSubsystem* EnhancedInput;
@@ -59,12 +157,14 @@ EUDSuccessStatus UUDCoreInputFunctionLibrary::AddInputMappingContexts(
 	}
 
 	TArray<int32> FailedIndices;
+	int32 NumMappings = 0;
 	for (int32 Index = 0; Index < Contexts.Num(); ++Index)
 	{
 		const auto& [InputContext, Priority] = Contexts[Index];
-		if (const UInputMappingContext* MappingContext = InputContext.LoadSynchronous())
+		if (const UInputMappingContext* MappingContext = LoadInputMappingContext(InputContext))
 		{
 			EnhancedInput->AddMappingContext(MappingContext, Priority);
+			NumMappings += GetNumMappings(MappingContext);
 		}
 		else
 		{
@@ -78,6 +178,8 @@ EUDSuccessStatus UUDCoreInputFunctionLibrary::AddInputMappingContexts(
 		UE_LOGFMT(LogUDCore, Warning, "{FailedIndicies} Input Mapping Contexts failed to load and were not added! The failed indexes are [{FailedIndicieIndexes}]", FailedIndices.Num(), FailedIndicesStr);
 	}
 
+	RecordContextChanges(*EnhancedInput, Contexts.Num() - FailedIndices.Num(), NumMappings);
+
 	UE_LOGFMT(LogUDCore, Verbose, "{MappingCount} Input mapping contexts set successfully.", Contexts.Num() - FailedIndices.Num());
 	return EUDSuccessStatus::Success;
 }
@@ -86,6 +188,7 @@ EUDSuccessStatus UUDCoreInputFunctionLibrary::RemoveInputMappingContexts(
 	AController* PlayerController,
 	const TArray<TSoftObjectPtr<UInputMappingContext>>& Contexts)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(UDCoreInput_RemoveInputMappingContexts);
 	if (Contexts.IsEmpty()) { return EUDSuccessStatus::Failure;; }
 
 	UEnhancedInputLocalPlayerSubsystem* EnhancedInput;
@@ -97,12 +200,14 @@ EUDSuccessStatus UUDCoreInputFunctionLibrary::RemoveInputMappingContexts(
 	}
 	
 	TArray<int32> FailedIndices;
+	int32 NumMappings = 0;
 	for (int32 Index = 0; Index < Contexts.Num(); ++Index)
 	{
 		const TSoftObjectPtr<UInputMappingContext>& Context = Contexts[Index];
-		if (const UInputMappingContext* MappingContext = Context.LoadSynchronous())
+		if (const UInputMappingContext* MappingContext = LoadInputMappingContext(Context))
 		{
 			EnhancedInput->RemoveMappingContext(MappingContext);
+			NumMappings += GetNumMappings(MappingContext);
 		} else
 		{
 			FailedIndices.Add(Index);
@@ -115,6 +220,8 @@ EUDSuccessStatus UUDCoreInputFunctionLibrary::RemoveInputMappingContexts(
 		UE_LOGFMT(LogUDCore, Warning, "{FailedIndicies} Input Mapping Contexts failed to load and were not removed! The failed indexes are [{FailedIndicieIndexes}]", FailedIndices.Num(), FailedIndicesStr);
 	}
 
+	RecordContextChanges(*EnhancedInput, Contexts.Num() - FailedIndices.Num(), NumMappings);
+
 	UE_LOGFMT(LogUDCore, Verbose, "{MappingCount} Input mapping contexts removed successfully.", Contexts.Num() - FailedIndices.Num());
 	return EUDSuccessStatus::Success;;
 }
@@ -126,8 +233,9 @@ EUDSuccessStatus UUDCoreInputFunctionLibrary::SwapInputMappingContexts(
  const int32 Priority,
  const bool bUsePreviousPriority)
 {
-	const UInputMappingContext* LoadedPreviousMappingContext = PreviousContext.LoadSynchronous();
-	const UInputMappingContext* LoadedNewMappingContext = NewContext.LoadSynchronous();
+	TRACE_CPUPROFILER_EVENT_SCOPE(UDCoreInput_SwapInputMappingContexts);
+	const UInputMappingContext* LoadedPreviousMappingContext = LoadInputMappingContext(PreviousContext);
+	const UInputMappingContext* LoadedNewMappingContext = LoadInputMappingContext(NewContext);
 
 	if (!LoadedPreviousMappingContext || !LoadedNewMappingContext)
 	{
@@ -154,5 +262,106 @@ EUDSuccessStatus UUDCoreInputFunctionLibrary::SwapInputMappingContexts(
 		UE_LOGFMT(LogUDCore, Warning, "Previous input mapping context {PreviousContext} not found. New context {NewContext} added at priority {BackupPriority}.", LoadedPreviousMappingContext->GetName(), LoadedNewMappingContext->GetName(), Priority);
 	}
 
+	RecordContextChanges(*EnhancedInput, 2, GetNumMappings(LoadedPreviousMappingContext) + GetNumMappings(LoadedNewMappingContext));
+
 	return EUDSuccessStatus::Success;
-}
\ No newline at end of file
+}
+
+EUDSuccessStatus UUDCoreInputFunctionLibrary::ApplyInputMappingContextSet(
+	AController* PlayerController,
+	const TArray<FUDCoreEnhancedInputContextData>& Contexts,
+	const bool bRemoveOthers,
+	const bool bIgnoreAllPressedKeysUntilRelease,
+	const bool bForceImmediately)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UDCoreInput_ApplyInputMappingContextSet);
+	UEnhancedInputLocalPlayerSubsystem* EnhancedInput;
+	if (!TryGetEnhancedInputSubsystemFromController(PlayerController, EnhancedInput))
+	{
+		return EUDSuccessStatus::Failure;
+	}
+
+	const UEnhancedPlayerInput* PlayerInput = EnhancedInput->GetPlayerInput();
+	if (!PlayerInput)
+	{
+		UE_LOG(LogUDCore, Warning, TEXT("EnhancedPlayerInput not found. Cannot apply input mapping context set."));
+		return EUDSuccessStatus::Failure;
+	}
+
+	TArray<TPair<const UInputMappingContext*, int32>, TInlineAllocator<16>> DesiredContexts;
+	DesiredContexts.Reserve(Contexts.Num());
+	for (const FUDCoreEnhancedInputContextData& Context : Contexts)
+	{
+		if (const UInputMappingContext* MappingContext = LoadInputMappingContext(Context.InputContext))
+		{
+			DesiredContexts.Emplace(MappingContext, Context.Priority);
+		}
+		else
+		{
+			UE_LOGFMT(LogUDCore, Warning, "Input mapping context {Context} failed to load and was not applied.", Context.InputContext.ToString());
+		}
+	}
+
+	// Diff against the applied contexts first, so the changes are known before any of them is made.
+	const TMap<TObjectPtr<const UInputMappingContext>, int32>& AppliedContexts = PlayerInput->GetAppliedInputContexts();
+	TArray<TPair<const UInputMappingContext*, int32>, TInlineAllocator<16>> ContextsToAdd;
+	TArray<const UInputMappingContext*, TInlineAllocator<16>> ContextsToRemove;
+	for (const TPair<const UInputMappingContext*, int32>& DesiredContext : DesiredContexts)
+	{
+		const int32* AppliedPriority = AppliedContexts.Find(DesiredContext.Key);
+		if (!AppliedPriority || *AppliedPriority != DesiredContext.Value)
+		{
+			ContextsToAdd.Add(DesiredContext);
+		}
+	}
+
+	if (bRemoveOthers)
+	{
+		for (const TPair<TObjectPtr<const UInputMappingContext>, int32>& AppliedContext : AppliedContexts)
+		{
+			const bool bDesired = DesiredContexts.ContainsByPredicate([&AppliedContext](const TPair<const UInputMappingContext*, int32>& DesiredContext)
+			{
+				return DesiredContext.Key == AppliedContext.Key;
+			});
+
+			if (!bDesired)
+			{
+				ContextsToRemove.Add(AppliedContext.Key);
+			}
+		}
+	}
+
+	const int32 NumChanges = ContextsToAdd.Num() + ContextsToRemove.Num();
+	if (NumChanges == 0)
+	{
+		UE_LOGFMT(LogUDCore, Verbose, "Input mapping context set already applied.");
+		return EUDSuccessStatus::Success;
+	}
+
+	// Only the last change may force the rebuild, the others leave it deferred so the set costs a single rebuild.
+	FModifyContextOptions Options;
+	Options.bIgnoreAllPressedKeysUntilRelease = bIgnoreAllPressedKeysUntilRelease;
+	Options.bForceImmediately = false;
+
+	int32 NumApplied = 0;
+	int32 NumMappings = 0;
+	for (const UInputMappingContext* MappingContext : ContextsToRemove)
+	{
+		Options.bForceImmediately = bForceImmediately && ++NumApplied == NumChanges;
+		EnhancedInput->RemoveMappingContext(MappingContext, Options);
+		NumMappings += GetNumMappings(MappingContext);
+	}
+
+	for (const TPair<const UInputMappingContext*, int32>& ContextToAdd : ContextsToAdd)
+	{
+		// Adding an applied context changes its priority.
+		Options.bForceImmediately = bForceImmediately && ++NumApplied == NumChanges;
+		EnhancedInput->AddMappingContext(ContextToAdd.Key, ContextToAdd.Value, Options);
+		NumMappings += GetNumMappings(ContextToAdd.Key);
+	}
+
+	RecordContextChanges(*EnhancedInput, NumChanges, NumMappings);
+
+	UE_LOGFMT(LogUDCore, Verbose, "Input mapping context set applied. {Added} added or re-prioritized, {Removed} removed.", ContextsToAdd.Num(), ContextsToRemove.Num());
+	return EUDSuccessStatus::Success;
+}
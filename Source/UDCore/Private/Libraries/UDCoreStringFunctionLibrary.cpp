@@ -2,53 +2,270 @@
 
 
 #include "Libraries/UDCoreStringFunctionLibrary.h"
+#include "Libraries/UDCoreStringKernels.h"
+#include "UDCoreCompatibility.h"
+#include "Async/ParallelFor.h"
+#include "Algo/Sort.h"
+#include "Internationalization/Text.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
-bool UUDCoreStringFunctionLibrary::ContainsLetters(const FString& String)
+static_assert(static_cast<uint8>(EUDCoreCharacterClass::Letter) == static_cast<uint8>(UDCoreStringKernels::ECharacterClass::Letter)
+	&& static_cast<uint8>(EUDCoreCharacterClass::Digit) == static_cast<uint8>(UDCoreStringKernels::ECharacterClass::Digit)
+	&& static_cast<uint8>(EUDCoreCharacterClass::Whitespace) == static_cast<uint8>(UDCoreStringKernels::ECharacterClass::Whitespace)
+	&& static_cast<uint8>(EUDCoreCharacterClass::Punctuation) == static_cast<uint8>(UDCoreStringKernels::ECharacterClass::Punctuation)
+	&& static_cast<uint8>(EUDCoreCharacterClass::Control) == static_cast<uint8>(UDCoreStringKernels::ECharacterClass::Control)
+	&& static_cast<uint8>(EUDCoreCharacterClass::NonAscii) == static_cast<uint8>(UDCoreStringKernels::ECharacterClass::NonAscii),
+	"EUDCoreCharacterClass must match the string kernel character classes.");
+
+namespace
 {
-	for (const TCHAR& Char : String)
+	/** Returns the character classes FilterCharacters removes for the provided flags. */
+	UDCoreStringKernels::ECharacterClass GetRemovedClasses(const bool bLetters, const bool bNumbers, const bool bSpecialCharacters, const bool bSpaces)
+	{
+		UDCoreStringKernels::ECharacterClass Classes = UDCoreStringKernels::ECharacterClass::None;
+		if (bLetters) { Classes |= UDCoreStringKernels::ECharacterClass::Letter; }
+		if (bNumbers) { Classes |= UDCoreStringKernels::ECharacterClass::Digit; }
+		if (bSpecialCharacters) { Classes |= UDCoreStringKernels::ECharacterClass::Punctuation; }
+		if (bSpaces) { Classes |= UDCoreStringKernels::ECharacterClass::Whitespace; }
+		return Classes;
+	}
+
+	/** The number of strings from which SortStringArrayInPlace sorts in parallel. */
+	constexpr int32 ParallelSortThreshold = 16 * 1024;
+
+	/** The least number of entries each parallel sort run holds. */
+	constexpr int32 MinSortRunSize = 4 * 1024;
+
+	/** A string to sort, with the first characters of its sort key packed so they compare as one integer. */
+	struct FStringSortEntry
 	{
-		if (FChar::IsAlpha(Char))
+		uint64 Prefix;
+		int32 Index;
+	};
+
+	/** Lower cases ASCII letters only, the way FString's default comparison does. */
+	FORCEINLINE uint16 FoldCase(const TCHAR Character)
+	{
+		return static_cast<uint16>(Character >= 'A' && Character <= 'Z' ? Character + ('a' - 'A') : Character);
+	}
+
+	FORCEINLINE bool IsAsciiDigit(const TCHAR Character)
+	{
+		return Character >= '0' && Character <= '9';
+	}
+
+	/** Compares the strings ignoring the case of ASCII letters, matching the prefix keys character for character. */
+	int32 CompareFolded(const TCHAR* CharA, const TCHAR* CharB)
+	{
+		for (; *CharA && FoldCase(*CharA) == FoldCase(*CharB); ++CharA, ++CharB) {}
+		return static_cast<int32>(FoldCase(*CharA)) - static_cast<int32>(FoldCase(*CharB));
+	}
+
+	/** Compares the strings with natural ordering, runs of digits comparing by their numeric value. */
+	int32 CompareNatural(const TCHAR* CharA, const TCHAR* CharB)
+	{
+		while (*CharA && *CharB)
 		{
-			return true;
+			if (IsAsciiDigit(*CharA) && IsAsciiDigit(*CharB))
+			{
+				const TCHAR* ValueA = CharA;
+				const TCHAR* ValueB = CharB;
+				while (*ValueA == '0') { ++ValueA; }
+				while (*ValueB == '0') { ++ValueB; }
+
+				const TCHAR* EndA = ValueA;
+				const TCHAR* EndB = ValueB;
+				while (IsAsciiDigit(*EndA)) { ++EndA; }
+				while (IsAsciiDigit(*EndB)) { ++EndB; }
+
+				// Without leading zeros, the longer number is the greater one.
+				if (EndA - ValueA != EndB - ValueB) { return EndA - ValueA < EndB - ValueB ? -1 : 1; }
+				for (; ValueA < EndA; ++ValueA, ++ValueB)
+				{
+					if (*ValueA != *ValueB) { return *ValueA < *ValueB ? -1 : 1; }
+				}
+
+				// Equal numbers order by their number of leading zeros.
+				if (EndA - CharA != EndB - CharB) { return EndA - CharA < EndB - CharB ? -1 : 1; }
+				CharA = EndA;
+				CharB = EndB;
+				continue;
+			}
+
+			const uint16 FoldedA = FoldCase(*CharA);
+			const uint16 FoldedB = FoldCase(*CharB);
+			if (FoldedA != FoldedB) { return FoldedA < FoldedB ? -1 : 1; }
+			++CharA;
+			++CharB;
 		}
+		return *CharA ? 1 : (*CharB ? -1 : 0);
 	}
-	return false;
-}
 
-bool UUDCoreStringFunctionLibrary::ContainsNumbers(const FString& String)
-{
-	for (const TCHAR& Char : String)
+	int32 CompareStrings(const FString& A, const FString& B, const EUDCoreStringSortMode SortMode)
 	{
-		if (FChar::IsDigit(Char))
+		switch (SortMode)
 		{
-			return true;
+		case EUDCoreStringSortMode::CaseSensitive:
+			return FCString::Strcmp(*A, *B);
+		case EUDCoreStringSortMode::Natural:
+			return CompareNatural(*A, *B);
+		case EUDCoreStringSortMode::Locale:
+			return FTextComparison::CompareTo(A, B);
+		default:
+			return CompareFolded(*A, *B);
 		}
 	}
-	return false;
-}
 
-bool UUDCoreStringFunctionLibrary::ContainsSpaces(const FString& String)
-{
-	for (const TCHAR& Char : String)
+	/**
+	 * Packs the first four characters of the string's sort key, so that a smaller prefix always means a smaller string.
+	 * Natural keys stop at the first digit, and locale collation has no prefix.
+	 */
+	uint64 MakeSortPrefix(const FString& String, const EUDCoreStringSortMode SortMode)
 	{
-		if (FChar::IsWhitespace(Char))
+		if (SortMode == EUDCoreStringSortMode::Locale) { return 0; }
+
+		uint64 Prefix = 0;
+		int32 Shift = 48;
+		for (const TCHAR* Character = *String; *Character && Shift >= 0; ++Character, Shift -= 16)
 		{
-			return true;
+			if (SortMode == EUDCoreStringSortMode::Natural && IsAsciiDigit(*Character))
+			{
+				// A number compares against other characters as its first digit would, '0' stands in for all of them.
+				Prefix |= static_cast<uint64>('0') << Shift;
+				break;
+			}
+			const uint16 Key = SortMode == EUDCoreStringSortMode::CaseSensitive ? static_cast<uint16>(*Character) : FoldCase(*Character);
+			Prefix |= static_cast<uint64>(Key) << Shift;
 		}
+		return Prefix;
 	}
-	return false;
-}
 
-bool UUDCoreStringFunctionLibrary::ContainsSpecialCharacters(const FString& String)
-{
-	for (const TCHAR& Char : String)
+	/** Sorts runs of the entries in parallel, then merges pairs of runs in parallel until one run is left. */
+	template <typename LessType>
+	void ParallelMergeSort(TArray<FStringSortEntry>& Entries, const LessType& Less)
 	{
-		if (FChar::IsPunct(Char))
+		const int32 NumEntries = Entries.Num();
+		const int32 MaxRuns = FMath::Min(NumEntries / MinSortRunSize, FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+		int32 NumRuns = 1;
+		while (NumRuns * 2 <= MaxRuns) { NumRuns *= 2; }
+		const auto RunStart = [NumEntries, NumRuns](const int32 Run) { return static_cast<int32>(static_cast<int64>(NumEntries) * Run / NumRuns); };
+
+		ParallelFor(NumRuns, [&Entries, &Less, &RunStart](const int32 Run)
 		{
-			return true;
+			Algo::Sort(MakeArrayView(Entries.GetData() + RunStart(Run), RunStart(Run + 1) - RunStart(Run)), Less);
+		});
+
+		TArray<FStringSortEntry> Scratch;
+		Scratch.SetNumUninitialized(NumEntries);
+		TArray<FStringSortEntry>* Source = &Entries;
+		TArray<FStringSortEntry>* Target = &Scratch;
+		for (int32 Width = 1; Width < NumRuns; Width *= 2)
+		{
+			ParallelFor(NumRuns / (2 * Width), [Source, Target, Width, &Less, &RunStart](const int32 Pair)
+			{
+				const FStringSortEntry* Left = Source->GetData() + RunStart(Pair * 2 * Width);
+				const FStringSortEntry* Middle = Source->GetData() + RunStart(Pair * 2 * Width + Width);
+				const FStringSortEntry* End = Source->GetData() + RunStart((Pair + 1) * 2 * Width);
+				const FStringSortEntry* Right = Middle;
+				FStringSortEntry* Output = Target->GetData() + RunStart(Pair * 2 * Width);
+
+				// Taking the left entry on ties keeps the merge stable.
+				while (Left < Middle && Right < End)
+				{
+					*Output++ = Less(*Right, *Left) ? *Right++ : *Left++;
+				}
+				while (Left < Middle) { *Output++ = *Left++; }
+				while (Right < End) { *Output++ = *Right++; }
+			});
+			Swap(Source, Target);
 		}
+
+		if (Source != &Entries)
+		{
+			Entries = MoveTemp(Scratch);
+		}
+	}
+
+	/** The number of characters a batch of strings is sized to, so a batch fits in the L1 cache. */
+	constexpr int32 BatchCharacters = 16 * 1024;
+
+	/**
+	 * Calls the function with the index of every string, splitting the strings into batches of about
+	 * BatchCharacters characters that run in parallel.
+	 */
+	template <typename FunctionType>
+	void ParallelForStringBatches(const TArray<FString>& Strings, FunctionType&& Function)
+	{
+		TArray<int32, TInlineAllocator<64>> BatchStarts;
+		int32 NumBatchCharacters = BatchCharacters;
+		for (int32 Index = 0; Index < Strings.Num(); ++Index)
+		{
+			if (NumBatchCharacters >= BatchCharacters)
+			{
+				BatchStarts.Add(Index);
+				NumBatchCharacters = 0;
+			}
+			NumBatchCharacters += Strings[Index].Len() + 1;
+		}
+		BatchStarts.Add(Strings.Num());
+
+		const int32 NumBatches = BatchStarts.Num() - 1;
+		ParallelFor(NumBatches, [&BatchStarts, &Function](const int32 BatchIndex)
+		{
+			for (int32 Index = BatchStarts[BatchIndex]; Index < BatchStarts[BatchIndex + 1]; ++Index)
+			{
+				Function(Index);
+			}
+		}, NumBatches <= 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
 	}
-	return false;
+}
+
+bool UUDCoreStringFunctionLibrary::ContainsLetters(const FString& String)
+{
+	return UDCoreStringKernels::ContainsAny(String, UDCoreStringKernels::ECharacterClass::Letter);
+}
+
+bool UUDCoreStringFunctionLibrary::ContainsNumbers(const FString& String)
+{
+	return UDCoreStringKernels::ContainsAny(String, UDCoreStringKernels::ECharacterClass::Digit);
+}
+
+bool UUDCoreStringFunctionLibrary::ContainsSpaces(const FString& String)
+{
+	return UDCoreStringKernels::ContainsAny(String, UDCoreStringKernels::ECharacterClass::Whitespace);
+}
+
+bool UUDCoreStringFunctionLibrary::ContainsSpecialCharacters(const FString& String)
+{
+	return UDCoreStringKernels::ContainsAny(String, UDCoreStringKernels::ECharacterClass::Punctuation);
+}
+
+FUDCoreCharacterProfile UUDCoreStringFunctionLibrary::GetCharacterProfile(const FString& String)
+{
+	UDCoreStringKernels::FClassCounts Counts;
+	UDCoreStringKernels::CountClasses(String, Counts);
+
+	FUDCoreCharacterProfile Profile;
+	Profile.Classes = static_cast<int32>(Counts.GetClasses());
+	Profile.NumCharacters = String.Len();
+	Profile.NumLetters = Counts.Counts[0];
+	Profile.NumDigits = Counts.Counts[1];
+	Profile.NumWhitespace = Counts.Counts[2];
+	Profile.NumPunctuation = Counts.Counts[3];
+	Profile.NumControl = Counts.Counts[4];
+	Profile.NumNonAscii = Counts.Counts[5];
+	Profile.NumUnclassified = Profile.NumCharacters - Profile.NumLetters - Profile.NumDigits - Profile.NumWhitespace - Profile.NumPunctuation - Profile.NumControl;
+	return Profile;
+}
+
+bool UUDCoreStringFunctionLibrary::CharacterProfileContainsAny(const FUDCoreCharacterProfile& Profile, const int32 Classes)
+{
+	return Profile.HasAny(static_cast<EUDCoreCharacterClass>(Classes));
+}
+
+bool UUDCoreStringFunctionLibrary::CharacterProfileContainsOnly(const FUDCoreCharacterProfile& Profile, const int32 Classes)
+{
+	return Profile.HasOnly(static_cast<EUDCoreCharacterClass>(Classes));
 }
 
 FString UUDCoreStringFunctionLibrary::FilterCharacters(
@@ -58,29 +275,177 @@ FString UUDCoreStringFunctionLibrary::FilterCharacters(
 	const bool bSpecialCharacters,
 	const bool bSpaces)
 {
-	FString NewString;
-	NewString.Reserve(String.Len());
-	
-	for (const TCHAR& Char : String)
+	FString NewString = String;
+	FilterCharactersInPlace(NewString, bLetters, bNumbers, bSpecialCharacters, bSpaces);
+	return NewString;
+}
+
+void UUDCoreStringFunctionLibrary::FilterCharactersInPlace(
+	FString& String,
+	const bool bLetters,
+	const bool bNumbers,
+	const bool bSpecialCharacters,
+	const bool bSpaces)
+{
+	const UDCoreStringKernels::ECharacterClass RemovedClasses = GetRemovedClasses(bLetters, bNumbers, bSpecialCharacters, bSpaces);
+	if (RemovedClasses == UDCoreStringKernels::ECharacterClass::None || String.IsEmpty()) { return; }
+
+	TArray<TCHAR>& Characters = String.GetCharArray();
+	const int32 NumWritten = UDCoreStringKernels::RemoveClasses(String, RemovedClasses, Characters.GetData());
+	Characters[NumWritten] = TEXT('\0');
+	Characters.SetNum(NumWritten + 1, UDCore::NoShrink);
+}
+
+void UUDCoreStringFunctionLibrary::FilterCharacters(
+	const FStringView String,
+	const bool bLetters,
+	const bool bNumbers,
+	const bool bSpecialCharacters,
+	const bool bSpaces,
+	TStringBuilderBase<TCHAR>& OutBuilder)
+{
+	const UDCoreStringKernels::ECharacterClass RemovedClasses = GetRemovedClasses(bLetters, bNumbers, bSpecialCharacters, bSpaces);
+	UDCoreStringKernels::ForEachKeptRun(String, RemovedClasses, [&OutBuilder](const TCHAR* Run, const int32 Length)
 	{
-		if (bLetters && FChar::IsAlpha(Char)) continue;
-		if (bNumbers && FChar::IsDigit(Char)) continue;
-		if (bSpecialCharacters && FChar::IsPunct(Char)) continue;
-		if (bSpaces && FChar::IsWhitespace(Char)) continue;
-		NewString.AppendChar(Char);
+		OutBuilder.Append(Run, Length);
+	});
+}
+
+int32 UUDCoreStringFunctionLibrary::FilterCharacters(
+	const FStringView String,
+	const bool bLetters,
+	const bool bNumbers,
+	const bool bSpecialCharacters,
+	const bool bSpaces,
+	TArrayView<TCHAR> OutBuffer)
+{
+	if (!ensureMsgf(OutBuffer.Num() >= String.Len(), TEXT("FilterCharacters needs a buffer of at least %d characters, got %d."), String.Len(), OutBuffer.Num()))
+	{
+		return 0;
 	}
-	return NewString;
+
+	const UDCoreStringKernels::ECharacterClass RemovedClasses = GetRemovedClasses(bLetters, bNumbers, bSpecialCharacters, bSpaces);
+	return UDCoreStringKernels::RemoveClasses(String, RemovedClasses, OutBuffer.GetData());
+}
+
+TArray<FString> UUDCoreStringFunctionLibrary::FilterCharactersBatch(
+	const TArray<FString>& Strings,
+	const bool bLetters,
+	const bool bNumbers,
+	const bool bSpecialCharacters,
+	const bool bSpaces)
+{
+	TArray<FString> FilteredStrings = Strings;
+	FilterCharactersBatchInPlace(FilteredStrings, bLetters, bNumbers, bSpecialCharacters, bSpaces);
+	return FilteredStrings;
+}
+
+void UUDCoreStringFunctionLibrary::FilterCharactersBatchInPlace(
+	TArray<FString>& Strings,
+	const bool bLetters,
+	const bool bNumbers,
+	const bool bSpecialCharacters,
+	const bool bSpaces)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UDCoreString_FilterCharactersBatch);
+
+	if (GetRemovedClasses(bLetters, bNumbers, bSpecialCharacters, bSpaces) == UDCoreStringKernels::ECharacterClass::None) { return; }
+
+	ParallelForStringBatches(Strings, [&Strings, bLetters, bNumbers, bSpecialCharacters, bSpaces](const int32 Index)
+	{
+		FilterCharactersInPlace(Strings[Index], bLetters, bNumbers, bSpecialCharacters, bSpaces);
+	});
+}
+
+TArray<bool> UUDCoreStringFunctionLibrary::ContainsCharacterClassesBatch(const TArray<FString>& Strings, const int32 Classes)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UDCoreString_ContainsCharacterClassesBatch);
+
+	TArray<bool> Results;
+	Results.SetNumZeroed(Strings.Num());
+
+	const UDCoreStringKernels::ECharacterClass KernelClasses = static_cast<UDCoreStringKernels::ECharacterClass>(Classes);
+	ParallelForStringBatches(Strings, [&Strings, &Results, KernelClasses](const int32 Index)
+	{
+		Results[Index] = UDCoreStringKernels::ContainsAny(Strings[Index], KernelClasses);
+	});
+	return Results;
+}
+
+TArray<FUDCoreCharacterProfile> UUDCoreStringFunctionLibrary::GetCharacterProfileBatch(const TArray<FString>& Strings)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UDCoreString_GetCharacterProfileBatch);
+
+	TArray<FUDCoreCharacterProfile> Profiles;
+	Profiles.SetNum(Strings.Num());
+
+	ParallelForStringBatches(Strings, [&Strings, &Profiles](const int32 Index)
+	{
+		Profiles[Index] = GetCharacterProfile(Strings[Index]);
+	});
+	return Profiles;
 }
 
 TArray<FString> UUDCoreStringFunctionLibrary::SortStringArray(TArray<FString> StringArray)
 {
-	Algo::Sort(StringArray);
+	SortStringArrayInPlace(StringArray);
 	return StringArray;
 }
 
-TArray<FString> UUDCoreStringFunctionLibrary::GetSortedStringArray(const TArray<FString> StringArray)
+TArray<FString> UUDCoreStringFunctionLibrary::GetSortedStringArray(const TArray<FString>& StringArray, const EUDCoreStringSortMode SortMode)
 {
 	TArray<FString> SortedArray = StringArray;
-	Algo::Sort(SortedArray);
+	SortStringArrayInPlace(SortedArray, SortMode);
 	return SortedArray;
-}
\ No newline at end of file
+}
+
+void UUDCoreStringFunctionLibrary::SortStringArrayInPlace(TArray<FString>& StringArray, const EUDCoreStringSortMode SortMode)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UDCoreString_SortStringArray);
+
+	const int32 NumStrings = StringArray.Num();
+	if (NumStrings < 2) { return; }
+
+	// Sort entries holding a prefix key of each string, so most comparisons never touch the strings.
+	TArray<FStringSortEntry> Entries;
+	Entries.SetNumUninitialized(NumStrings);
+	ParallelFor(NumStrings, [&StringArray, &Entries, SortMode](const int32 Index)
+	{
+		Entries[Index] = { MakeSortPrefix(StringArray[Index], SortMode), Index };
+	}, NumStrings < ParallelSortThreshold ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	// Equal strings are ordered by their index, which makes the sort stable.
+	const auto Less = [&StringArray, SortMode](const FStringSortEntry& A, const FStringSortEntry& B)
+	{
+		if (A.Prefix != B.Prefix) { return A.Prefix < B.Prefix; }
+		const int32 Result = CompareStrings(StringArray[A.Index], StringArray[B.Index], SortMode);
+		return Result != 0 ? Result < 0 : A.Index < B.Index;
+	};
+
+	if (NumStrings < ParallelSortThreshold)
+	{
+		Algo::Sort(Entries, Less);
+	}
+	else
+	{
+		ParallelMergeSort(Entries, Less);
+	}
+
+	// Move the strings to their sorted position by following the cycles of the permutation.
+	for (int32 Start = 0; Start < NumStrings; ++Start)
+	{
+		if (Entries[Start].Index == Start) { continue; }
+
+		FString StartString = MoveTemp(StringArray[Start]);
+		int32 Position = Start;
+		while (Entries[Position].Index != Start)
+		{
+			const int32 Next = Entries[Position].Index;
+			StringArray[Position] = MoveTemp(StringArray[Next]);
+			Entries[Position].Index = Position;
+			Position = Next;
+		}
+		StringArray[Position] = MoveTemp(StartString);
+		Entries[Position].Index = Position;
+	}
+}
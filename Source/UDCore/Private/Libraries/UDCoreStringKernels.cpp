@@ -0,0 +1,159 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+
+#include "Libraries/UDCoreStringKernels.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+	#define UDCORE_STRING_KERNELS_SSE 1
+	#include <emmintrin.h>
+#elif PLATFORM_ENABLE_VECTORINTRINSICS_NEON && PLATFORM_CPU_ARM_FAMILY && PLATFORM_64BITS
+	#define UDCORE_STRING_KERNELS_NEON 1
+	#include <arm_neon.h>
+#endif
+
+#ifndef UDCORE_STRING_KERNELS_SSE
+	#define UDCORE_STRING_KERNELS_SSE 0
+#endif
+#ifndef UDCORE_STRING_KERNELS_NEON
+	#define UDCORE_STRING_KERNELS_NEON 0
+#endif
+
+namespace UDCoreStringKernels
+{
+	namespace
+	{
+		static_assert(sizeof(TCHAR) == 2, "The vectorized kernels classify UTF-16 code units.");
+
+#if UDCORE_STRING_KERNELS_SSE
+		FORCEINLINE __m128i Between(const __m128i Value, const int16 Min, const int16 Max)
+		{
+			return _mm_and_si128(_mm_cmpgt_epi16(Value, _mm_set1_epi16(Min - 1)), _mm_cmplt_epi16(Value, _mm_set1_epi16(Max + 1)));
+		}
+
+		/** Packs the lane masks to one bit per character. */
+		FORCEINLINE uint32 ToBits(const __m128i Mask)
+		{
+			return static_cast<uint32>(_mm_movemask_epi8(_mm_packs_epi16(Mask, _mm_setzero_si128()))) & 0xFF;
+		}
+
+		/** Classifies a full chunk of ASCII characters. Returns false if the chunk holds a non-ASCII character. */
+		FORCEINLINE bool ClassifyAsciiChunk(const TCHAR* Characters, FChunkClasses& OutClasses)
+		{
+			const __m128i Value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Characters));
+			const __m128i Ascii = _mm_cmpeq_epi16(_mm_and_si128(Value, _mm_set1_epi16(static_cast<int16>(0xFF80))), _mm_setzero_si128());
+			if (_mm_movemask_epi8(Ascii) != 0xFFFF) { return false; }
+
+			// The ASCII values are positive as signed 16 bit integers, so the signed compares hold.
+			const __m128i Letter = Between(_mm_or_si128(Value, _mm_set1_epi16(0x20)), 'a', 'z');
+			const __m128i Digit = Between(Value, '0', '9');
+			const __m128i Whitespace = _mm_or_si128(_mm_cmpeq_epi16(Value, _mm_set1_epi16(' ')), Between(Value, 0x09, 0x0D));
+			const __m128i Punctuation = _mm_andnot_si128(_mm_or_si128(Letter, Digit), Between(Value, 0x21, 0x7E));
+			const __m128i Control = _mm_andnot_si128(Whitespace, _mm_or_si128(_mm_cmplt_epi16(Value, _mm_set1_epi16(0x20)), _mm_cmpeq_epi16(Value, _mm_set1_epi16(0x7F))));
+
+			OutClasses.Masks[0] = ToBits(Letter);
+			OutClasses.Masks[1] = ToBits(Digit);
+			OutClasses.Masks[2] = ToBits(Whitespace);
+			OutClasses.Masks[3] = ToBits(Punctuation);
+			OutClasses.Masks[4] = ToBits(Control);
+			OutClasses.Masks[5] = 0;
+			return true;
+		}
+#elif UDCORE_STRING_KERNELS_NEON
+		FORCEINLINE uint16x8_t Between(const uint16x8_t Value, const uint16 Min, const uint16 Max)
+		{
+			return vandq_u16(vcgeq_u16(Value, vdupq_n_u16(Min)), vcleq_u16(Value, vdupq_n_u16(Max)));
+		}
+
+		/** Packs the lane masks to one bit per character. */
+		FORCEINLINE uint32 ToBits(const uint16x8_t Mask)
+		{
+			static const uint16 LaneBits[ChunkSize] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+			return vaddvq_u16(vandq_u16(Mask, vld1q_u16(LaneBits)));
+		}
+
+		/** Classifies a full chunk of ASCII characters. Returns false if the chunk holds a non-ASCII character. */
+		FORCEINLINE bool ClassifyAsciiChunk(const TCHAR* Characters, FChunkClasses& OutClasses)
+		{
+			const uint16x8_t Value = vld1q_u16(reinterpret_cast<const uint16*>(Characters));
+			if (vmaxvq_u16(Value) >= 0x80) { return false; }
+
+			const uint16x8_t Letter = Between(vorrq_u16(Value, vdupq_n_u16(0x20)), 'a', 'z');
+			const uint16x8_t Digit = Between(Value, '0', '9');
+			const uint16x8_t Whitespace = vorrq_u16(vceqq_u16(Value, vdupq_n_u16(' ')), Between(Value, 0x09, 0x0D));
+			const uint16x8_t Punctuation = vbicq_u16(Between(Value, 0x21, 0x7E), vorrq_u16(Letter, Digit));
+			const uint16x8_t Control = vbicq_u16(vorrq_u16(vcltq_u16(Value, vdupq_n_u16(0x20)), vceqq_u16(Value, vdupq_n_u16(0x7F))), Whitespace);
+
+			OutClasses.Masks[0] = ToBits(Letter);
+			OutClasses.Masks[1] = ToBits(Digit);
+			OutClasses.Masks[2] = ToBits(Whitespace);
+			OutClasses.Masks[3] = ToBits(Punctuation);
+			OutClasses.Masks[4] = ToBits(Control);
+			OutClasses.Masks[5] = 0;
+			return true;
+		}
+#endif
+	}
+
+	void ClassifyChunk(const TCHAR* Characters, const int32 NumCharacters, FChunkClasses& OutClasses)
+	{
+#if UDCORE_STRING_KERNELS_SSE || UDCORE_STRING_KERNELS_NEON
+		if (NumCharacters == ChunkSize && ClassifyAsciiChunk(Characters, OutClasses)) { return; }
+#endif
+
+		OutClasses = FChunkClasses();
+		for (int32 Index = 0; Index < NumCharacters; ++Index)
+		{
+			const uint8 Classes = static_cast<uint8>(ClassifyCharacter(Characters[Index]));
+			for (int32 ClassIndex = 0; ClassIndex < NumCharacterClasses; ++ClassIndex)
+			{
+				OutClasses.Masks[ClassIndex] |= ((Classes >> ClassIndex) & 1) << Index;
+			}
+		}
+	}
+
+	void CountClasses(const FStringView String, FClassCounts& OutCounts)
+	{
+		const TCHAR* Characters = String.GetData();
+		const int32 NumCharacters = String.Len();
+
+		OutCounts = FClassCounts();
+		FChunkClasses ChunkClasses;
+		for (int32 Start = 0; Start < NumCharacters; Start += ChunkSize)
+		{
+			ClassifyChunk(Characters + Start, FMath::Min(ChunkSize, NumCharacters - Start), ChunkClasses);
+			for (int32 ClassIndex = 0; ClassIndex < NumCharacterClasses; ++ClassIndex)
+			{
+				OutCounts.Counts[ClassIndex] += static_cast<int32>(FMath::CountBits(ChunkClasses.Masks[ClassIndex]));
+			}
+		}
+	}
+
+	bool ContainsAny(const FStringView String, const ECharacterClass Classes)
+	{
+		const TCHAR* Characters = String.GetData();
+		const int32 NumCharacters = String.Len();
+
+		FChunkClasses ChunkClasses;
+		for (int32 Start = 0; Start < NumCharacters; Start += ChunkSize)
+		{
+			ClassifyChunk(Characters + Start, FMath::Min(ChunkSize, NumCharacters - Start), ChunkClasses);
+			if (ChunkClasses.GetMask(Classes) != 0) { return true; }
+		}
+		return false;
+	}
+
+	int32 RemoveClasses(const FStringView String, const ECharacterClass RemovedClasses, TCHAR* OutCharacters)
+	{
+		// Runs are written at or before where they are read, so filtering in place is safe with a move.
+		int32 NumWritten = 0;
+		ForEachKeptRun(String, RemovedClasses, [OutCharacters, &NumWritten](const TCHAR* Run, const int32 Length)
+		{
+			if (OutCharacters + NumWritten != Run)
+			{
+				FMemory::Memmove(OutCharacters + NumWritten, Run, Length * sizeof(TCHAR));
+			}
+			NumWritten += Length;
+		});
+		return NumWritten;
+	}
+}
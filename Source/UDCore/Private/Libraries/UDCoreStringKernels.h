@@ -0,0 +1,145 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Character classification kernels shared by the UUDCoreStringFunctionLibrary functions.
+ * Runs of ASCII characters are classified 8 UTF-16 code units at a time with SSE2 or NEON,
+ * chunks holding non-ASCII characters fall back to the FChar functions.
+ */
+namespace UDCoreStringKernels
+{
+	/** The classes a character can belong to. A character is in at most one of the first five classes. */
+	enum class ECharacterClass : uint8
+	{
+		None = 0,
+		Letter = 1 << 0,
+		Digit = 1 << 1,
+		Whitespace = 1 << 2,
+		Punctuation = 1 << 3,
+		Control = 1 << 4,
+		NonAscii = 1 << 5,
+	};
+	ENUM_CLASS_FLAGS(ECharacterClass)
+
+	constexpr int32 NumCharacterClasses = 6;
+
+	/** The number of characters classified together. */
+	constexpr int32 ChunkSize = 8;
+
+	/** The classes of a chunk of characters, as one bit per character for each class. */
+	struct FChunkClasses
+	{
+		uint32 Masks[NumCharacterClasses] = {};
+
+		/** Returns the characters of the chunk that are in any of the classes. */
+		uint32 GetMask(const ECharacterClass Classes) const
+		{
+			uint32 Mask = 0;
+			for (int32 ClassIndex = 0; ClassIndex < NumCharacterClasses; ++ClassIndex)
+			{
+				Mask |= (static_cast<uint8>(Classes) & (1 << ClassIndex)) ? Masks[ClassIndex] : 0;
+			}
+			return Mask;
+		}
+	};
+
+	/** Returns the classes of the character, the same way the FChar functions classify it. */
+	inline ECharacterClass ClassifyCharacter(const TCHAR Character)
+	{
+		ECharacterClass Classes = ECharacterClass::None;
+		if (FChar::IsAlpha(Character)) { Classes |= ECharacterClass::Letter; }
+		else if (FChar::IsDigit(Character)) { Classes |= ECharacterClass::Digit; }
+		else if (FChar::IsWhitespace(Character)) { Classes |= ECharacterClass::Whitespace; }
+		else if (FChar::IsPunct(Character)) { Classes |= ECharacterClass::Punctuation; }
+		else if (Character < 0x20 || (Character >= 0x7F && Character <= 0x9F)) { Classes |= ECharacterClass::Control; }
+
+		if (Character >= 0x80) { Classes |= ECharacterClass::NonAscii; }
+		return Classes;
+	}
+
+	/**
+	 * Classifies up to ChunkSize characters.
+	 * @param Characters The characters to classify.
+	 * @param NumCharacters The number of characters to classify, at most ChunkSize.
+	 * @param OutClasses The classes of the characters, bit N standing for the Nth character.
+	 */
+	void ClassifyChunk(const TCHAR* Characters, int32 NumCharacters, FChunkClasses& OutClasses);
+
+	/** The number of characters of each class in a string. */
+	struct FClassCounts
+	{
+		int32 Counts[NumCharacterClasses] = {};
+
+		/** Returns the classes that have at least one character. */
+		ECharacterClass GetClasses() const
+		{
+			uint8 Classes = 0;
+			for (int32 ClassIndex = 0; ClassIndex < NumCharacterClasses; ++ClassIndex)
+			{
+				Classes |= Counts[ClassIndex] > 0 ? (1 << ClassIndex) : 0;
+			}
+			return static_cast<ECharacterClass>(Classes);
+		}
+	};
+
+	/** Counts the characters of each class in the string in a single pass. */
+	void CountClasses(FStringView String, FClassCounts& OutCounts);
+
+	/** Returns true if the string contains a character of any of the classes. */
+	bool ContainsAny(FStringView String, ECharacterClass Classes);
+
+	/**
+	 * Calls the function with each run of consecutive characters that are not in any of the removed classes.
+	 * Chunks that are kept whole are merged into a single run, chunks that are removed whole are skipped.
+	 * @param String The string to scan.
+	 * @param RemovedClasses The classes of the characters to skip.
+	 * @param Function Called with the start and length of each kept run, in order.
+	 */
+	template <typename FunctionType>
+	void ForEachKeptRun(const FStringView String, const ECharacterClass RemovedClasses, FunctionType&& Function)
+	{
+		const TCHAR* Characters = String.GetData();
+		const int32 NumCharacters = String.Len();
+
+		int32 RunStart = 0;
+		int32 RunLength = 0;
+		FChunkClasses ChunkClasses;
+		for (int32 Start = 0; Start < NumCharacters; Start += ChunkSize)
+		{
+			const int32 NumChunkCharacters = FMath::Min(ChunkSize, NumCharacters - Start);
+			ClassifyChunk(Characters + Start, NumChunkCharacters, ChunkClasses);
+
+			uint32 Kept = ~ChunkClasses.GetMask(RemovedClasses) & ((1u << NumChunkCharacters) - 1);
+			while (Kept != 0)
+			{
+				const int32 Index = static_cast<int32>(FMath::CountTrailingZeros(Kept));
+				const int32 Length = static_cast<int32>(FMath::CountTrailingZeros(~(Kept >> Index)));
+				if (RunLength > 0 && RunStart + RunLength == Start + Index)
+				{
+					RunLength += Length;
+				}
+				else
+				{
+					if (RunLength > 0) { Function(Characters + RunStart, RunLength); }
+					RunStart = Start + Index;
+					RunLength = Length;
+				}
+				Kept &= ~(((1u << Length) - 1) << Index);
+			}
+		}
+
+		if (RunLength > 0) { Function(Characters + RunStart, RunLength); }
+	}
+
+	/**
+	 * Copies the characters that are not in any of the removed classes.
+	 * @param String The string to filter.
+	 * @param RemovedClasses The classes of the characters to remove.
+	 * @param OutCharacters Receives the kept characters, must hold String.Len() characters. May be String itself.
+	 * @returns The number of characters written.
+	 */
+	int32 RemoveClasses(FStringView String, ECharacterClass RemovedClasses, TCHAR* OutCharacters);
+}
@@ -0,0 +1,60 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+
+#include "Subsystems/UDCoreInputContextPreloader.h"
+#include "UDCoreLogChannels.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "InputMappingContext.h"
+
+void UUDCoreInputContextPreloader::PreloadInputMappingContexts(const TArray<TSoftObjectPtr<UInputMappingContext>>& Contexts)
+{
+	TArray<FSoftObjectPath> PathsToLoad;
+	PathsToLoad.Reserve(Contexts.Num());
+	for (const TSoftObjectPtr<UInputMappingContext>& Context : Contexts)
+	{
+		if (!Context.IsNull() && !PreloadHandles.Contains(Context.ToSoftObjectPath()))
+		{
+			PathsToLoad.AddUnique(Context.ToSoftObjectPath());
+		}
+	}
+
+	if (PathsToLoad.IsEmpty()) { return; }
+
+	const TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		PathsToLoad,
+		FStreamableDelegate(),
+		FStreamableManager::DefaultAsyncLoadPriority);
+
+	for (const FSoftObjectPath& Path : PathsToLoad)
+	{
+		PreloadHandles.Add(Path, Handle);
+	}
+
+	UE_LOG(LogUDCore, Verbose, TEXT("Preloading %i input mapping contexts."), PathsToLoad.Num());
+}
+
+void UUDCoreInputContextPreloader::ReleaseInputMappingContexts(const TArray<TSoftObjectPtr<UInputMappingContext>>& Contexts)
+{
+	for (const TSoftObjectPtr<UInputMappingContext>& Context : Contexts)
+	{
+		// The handle is released once every context loaded with it has been released.
+		PreloadHandles.Remove(Context.ToSoftObjectPath());
+	}
+}
+
+bool UUDCoreInputContextPreloader::AreInputMappingContextsLoaded(const TArray<TSoftObjectPtr<UInputMappingContext>>& Contexts) const
+{
+	for (const TSoftObjectPtr<UInputMappingContext>& Context : Contexts)
+	{
+		if (!Context.IsNull() && !Context.IsValid()) { return false; }
+	}
+	return true;
+}
+
+void UUDCoreInputContextPreloader::Deinitialize()
+{
+	PreloadHandles.Empty();
+
+	Super::Deinitialize();
+}
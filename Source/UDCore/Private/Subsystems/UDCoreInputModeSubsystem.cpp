@@ -0,0 +1,169 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+
+#include "Subsystems/UDCoreInputModeSubsystem.h"
+#include "Input/UDCoreInputModeData.h"
+#include "UDCoreLogChannels.h"
+#include "UDCoreCompatibility.h"
+#include "EnhancedInputSubsystems.h"
+#include "EnhancedPlayerInput.h"
+#include "InputMappingContext.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "TimerManager.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+namespace
+{
+	FAutoConsoleCommandWithWorld CmdDumpInputModeStack(
+		TEXT("UDCore.Input.DumpModeStack"),
+		TEXT("Logs the input mode stack of every local player and the contexts it applies."),
+		FConsoleCommandWithWorldDelegate::CreateStatic([](const UWorld* World)
+		{
+			const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+			if (!GameInstance) { return; }
+
+			for (const ULocalPlayer* LocalPlayer : GameInstance->GetLocalPlayers())
+			{
+				if (const UUDCoreInputModeSubsystem* InputModes = LocalPlayer ? LocalPlayer->GetSubsystem<UUDCoreInputModeSubsystem>() : nullptr)
+				{
+					UE_LOG(LogUDCore, Log, TEXT("Local player %i: %s"), LocalPlayer->GetLocalPlayerIndex(), *InputModes->GetDebugString());
+				}
+			}
+		}));
+}
+
+void UUDCoreInputModeSubsystem::PushInputMode(UUDCoreInputModeData* InputMode)
+{
+	if (!InputMode)
+	{
+		UE_LOG(LogUDCore, Warning, TEXT("InputMode is null. Cannot push input mode."));
+		return;
+	}
+
+	InputMode->ResolveContexts();
+	Stack.Add(InputMode);
+	ApplyStack();
+}
+
+bool UUDCoreInputModeSubsystem::PopInputMode(UUDCoreInputModeData* InputMode)
+{
+	const int32 ModeIndex = InputMode ? Stack.FindLast(InputMode) : Stack.Num() - 1;
+	if (!Stack.IsValidIndex(ModeIndex)) { return false; }
+
+	Stack.RemoveAt(ModeIndex, 1, UDCore::NoShrink);
+	ApplyStack();
+	return true;
+}
+
+void UUDCoreInputModeSubsystem::ClearInputModes()
+{
+	Stack.Reset();
+	ApplyStack();
+}
+
+void UUDCoreInputModeSubsystem::PlayerControllerChanged(APlayerController* NewPlayerController)
+{
+	Super::PlayerControllerChanged(NewPlayerController);
+
+	// The new controller starts without any context, and its player input may not exist until it finishes initializing.
+	AppliedContexts.Reset();
+	AppliedPriorities.Reset();
+	if (NewPlayerController && Stack.Num() > 0)
+	{
+		NewPlayerController->GetWorldTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UUDCoreInputModeSubsystem::ApplyStack));
+	}
+}
+
+void UUDCoreInputModeSubsystem::ApplyStack()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UDCoreInput_ApplyInputModeStack);
+
+	// Gather the contexts from the top of the stack, the first mode to list a context decides its priority.
+	DesiredContexts.Reset();
+	DesiredPriorities.Reset();
+	for (int32 ModeIndex = Stack.Num() - 1; ModeIndex >= 0; --ModeIndex)
+	{
+		const UUDCoreInputModeData* InputMode = Stack[ModeIndex];
+		if (!InputMode) { continue; }
+
+		const TConstArrayView<TObjectPtr<const UInputMappingContext>> ModeContexts = InputMode->GetResolvedContexts();
+		const TConstArrayView<int32> ModePriorities = InputMode->GetResolvedPriorities();
+		for (int32 ContextIndex = 0; ContextIndex < ModeContexts.Num(); ++ContextIndex)
+		{
+			if (!DesiredContexts.Contains(ModeContexts[ContextIndex]))
+			{
+				DesiredContexts.Add(ModeContexts[ContextIndex]);
+				DesiredPriorities.Add(ModePriorities[ContextIndex]);
+			}
+		}
+
+		if (InputMode->bBlocksLowerModes) { break; }
+	}
+
+	const ULocalPlayer* LocalPlayer = GetLocalPlayer();
+	UEnhancedInputLocalPlayerSubsystem* EnhancedInput = LocalPlayer ? LocalPlayer->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>() : nullptr;
+	if (!EnhancedInput)
+	{
+		UE_LOG(LogUDCore, Warning, TEXT("EnhancedInput subsystem not found. Cannot apply input modes."));
+		return;
+	}
+
+	// Without a player input nothing is applied yet, the stack is applied once the player controller is set.
+	const UEnhancedPlayerInput* PlayerInput = EnhancedInput->GetPlayerInput();
+	if (!PlayerInput)
+	{
+		AppliedContexts.Reset();
+		AppliedPriorities.Reset();
+		return;
+	}
+
+	// Diff against what Enhanced Input actually has applied, which may have been cleared or replaced outside of the stack.
+	// Every change leaves the rebuild deferred, so the whole transition costs a single rebuild.
+	const TMap<TObjectPtr<const UInputMappingContext>, int32>& EnhancedInputContexts = PlayerInput->GetAppliedInputContexts();
+	const FModifyContextOptions Options;
+	for (int32 AppliedIndex = 0; AppliedIndex < AppliedContexts.Num(); ++AppliedIndex)
+	{
+		if (!DesiredContexts.Contains(AppliedContexts[AppliedIndex]) && EnhancedInputContexts.Contains(AppliedContexts[AppliedIndex]))
+		{
+			EnhancedInput->RemoveMappingContext(AppliedContexts[AppliedIndex], Options);
+		}
+	}
+
+	for (int32 DesiredIndex = 0; DesiredIndex < DesiredContexts.Num(); ++DesiredIndex)
+	{
+		const int32* AppliedPriority = EnhancedInputContexts.Find(DesiredContexts[DesiredIndex]);
+		if (!AppliedPriority || *AppliedPriority != DesiredPriorities[DesiredIndex])
+		{
+			EnhancedInput->AddMappingContext(DesiredContexts[DesiredIndex], DesiredPriorities[DesiredIndex], Options);
+		}
+	}
+
+	Swap(AppliedContexts, DesiredContexts);
+	Swap(AppliedPriorities, DesiredPriorities);
+}
+
+FString UUDCoreInputModeSubsystem::GetDebugString() const
+{
+	TStringBuilder<256> Builder;
+	Builder << TEXT("Input modes (bottom to top): ");
+	for (int32 ModeIndex = 0; ModeIndex < Stack.Num(); ++ModeIndex)
+	{
+		Builder << (ModeIndex > 0 ? TEXT(", ") : TEXT("")) << GetNameSafe(Stack[ModeIndex]);
+		if (Stack[ModeIndex] && Stack[ModeIndex]->bBlocksLowerModes)
+		{
+			Builder << TEXT(" (blocking)");
+		}
+	}
+
+	Builder << TEXT(". Applied contexts: ");
+	for (int32 ContextIndex = 0; ContextIndex < AppliedContexts.Num(); ++ContextIndex)
+	{
+		Builder.Appendf(TEXT("%s%s (%d)"), ContextIndex > 0 ? TEXT(", ") : TEXT(""), *GetNameSafe(AppliedContexts[ContextIndex]), AppliedPriorities[ContextIndex]);
+	}
+
+	return Builder.ToString();
+}
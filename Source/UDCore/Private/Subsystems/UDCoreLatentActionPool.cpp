@@ -0,0 +1,92 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+
+#include "Subsystems/UDCoreLatentActionPool.h"
+#include "UDCoreStats.h"
+#include "UDCoreCompatibility.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Latent Actions Allocated"), STAT_UDCoreLatentActionsAllocated, STATGROUP_UDCore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Latent Actions Reused"), STAT_UDCoreLatentActionsReused, STATGROUP_UDCore);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Latent Actions"), STAT_UDCorePooledLatentActions, STATGROUP_UDCore);
+
+namespace
+{
+	bool GLatentActionPoolEnabled = false;
+	FAutoConsoleVariableRef CVarLatentActionPoolEnabled(
+		TEXT("UDCore.LatentActionPool.Enable"),
+		GLatentActionPoolEnabled,
+		TEXT("Reuse completed UDCore latent actions instead of letting them be garbage collected. Blueprints must not use a latent action after it has completed when enabled."));
+
+	int32 GLatentActionPoolMaxPerClass = 256;
+	FAutoConsoleVariableRef CVarLatentActionPoolMaxPerClass(
+		TEXT("UDCore.LatentActionPool.MaxPerClass"),
+		GLatentActionPoolMaxPerClass,
+		TEXT("The maximum number of free latent actions kept per class. Completed actions over this limit are garbage collected."));
+}
+
+UBlueprintAsyncActionBase* UUDCoreLatentActionPool::NewAction(const UObject* WorldContextObject, UClass* ActionClass)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	UUDCoreLatentActionPool* Pool = GameInstance && IsPoolingEnabled() ? GameInstance->GetSubsystem<UUDCoreLatentActionPool>() : nullptr;
+	if (!Pool)
+	{
+		INC_DWORD_STAT(STAT_UDCoreLatentActionsAllocated);
+		return NewObject<UBlueprintAsyncActionBase>(GetTransientPackage(), ActionClass);
+	}
+
+	if (FUDLatentActionPoolList* FreeList = Pool->FreeActions.Find(ActionClass))
+	{
+		if (FreeList->Actions.Num() > 0)
+		{
+			INC_DWORD_STAT(STAT_UDCoreLatentActionsReused);
+			DEC_DWORD_STAT(STAT_UDCorePooledLatentActions);
+			return FreeList->Actions.Pop(UDCore::NoShrink);
+		}
+	}
+
+	// Actions are outered to the pool that created them so they find their way back to it.
+	INC_DWORD_STAT(STAT_UDCoreLatentActionsAllocated);
+	return NewObject<UBlueprintAsyncActionBase>(Pool, ActionClass);
+}
+
+void UUDCoreLatentActionPool::ReleaseAction(UBlueprintAsyncActionBase* Action)
+{
+	UUDCoreLatentActionPool* Pool = Action ? Cast<UUDCoreLatentActionPool>(Action->GetOuter()) : nullptr;
+	IUDCorePoolableLatentAction* PoolableAction = Cast<IUDCorePoolableLatentAction>(Action);
+	if (!Pool || !PoolableAction || !IsPoolingEnabled()) { return; }
+
+	FUDLatentActionPoolList& FreeList = Pool->FreeActions.FindOrAdd(Action->GetClass());
+	if (FreeList.Actions.Num() >= GLatentActionPoolMaxPerClass) { return; }
+
+	PoolableAction->ResetForPool();
+	FreeList.Actions.Add(Action);
+	INC_DWORD_STAT(STAT_UDCorePooledLatentActions);
+}
+
+bool UUDCoreLatentActionPool::IsPoolingEnabled()
+{
+	return GLatentActionPoolEnabled;
+}
+
+int32 UUDCoreLatentActionPool::GetNumFreeActions() const
+{
+	int32 NumFreeActions = 0;
+	for (const TPair<TObjectPtr<UClass>, FUDLatentActionPoolList>& FreeList : FreeActions)
+	{
+		NumFreeActions += FreeList.Value.Actions.Num();
+	}
+	return NumFreeActions;
+}
+
+void UUDCoreLatentActionPool::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_UDCorePooledLatentActions, GetNumFreeActions());
+	FreeActions.Empty();
+
+	Super::Deinitialize();
+}
@@ -1,18 +1,44 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "UDCore.h"
+#include "Input/UDCoreInputLatencyProbe.h"
+
+#if WITH_GAMEPLAY_DEBUGGER
+#include "GameplayDebugger.h"
+#include "AI/GameplayDebuggerCategory_UDCoreMove.h"
+#endif
 
 #define LOCTEXT_NAMESPACE "FUDCoreModule"
 
 void FUDCoreModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+
+#if WITH_GAMEPLAY_DEBUGGER
+	IGameplayDebugger& GameplayDebuggerModule = IGameplayDebugger::Get();
+	GameplayDebuggerModule.RegisterCategory(
+		"UDCoreMove",
+		IGameplayDebugger::FOnGetCategory::CreateStatic(&FGameplayDebuggerCategory_UDCoreMove::MakeInstance),
+		EGameplayDebuggerCategoryState::Disabled);
+	GameplayDebuggerModule.NotifyCategoriesChanged();
+#endif
 }
 
 void FUDCoreModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+
+	FUDCoreInputLatencyProbe::SetEnabled(false);
+
+#if WITH_GAMEPLAY_DEBUGGER
+	if (IGameplayDebugger::IsAvailable())
+	{
+		IGameplayDebugger& GameplayDebuggerModule = IGameplayDebugger::Get();
+		GameplayDebuggerModule.UnregisterCategory("UDCoreMove");
+		GameplayDebuggerModule.NotifyCategoriesChanged();
+	}
+#endif
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,122 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "GameFramework/Controller.h"
+#include "AI/UDCoreMoveSubsystem.h"
+#include "Subsystems/UDCoreLatentActionPool.h"
+#include "UDAT_GroupMoveToLocation.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnAsyncGroupMemberMoveToLocation, AController*, Controller, bool, bSuccess);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAsyncGroupMoveToLocation, bool, bSuccess);
+
+/**
+ * UDAT_GroupMoveToLocation
+ * Asynchronously moves a group of actors to a location in formation, sharing a single path computation.
+ */
+UCLASS(BlueprintType, meta=(ExposedAsyncProxy = AsyncTask, DisplayName="Async Group Move To Location"))
+class UDCORE_API UUDAT_GroupMoveToLocation : public UBlueprintAsyncActionBase, public IUDCorePoolableLatentAction
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Moves the controllers to the specified location in formation.
+	 * One path is found for the whole group and every controller follows it to its own formation slot around the destination.
+	 * MemberCompleted is called for every controller when its movement has succeeded or failed,
+	 * Completed is called once every controller is done.
+	 *
+	 * If a controller or pawn is destroyed while moving, its movement fails.
+	 * If bCheckStuckMovement is enabled and a controller gets stuck while moving, it finds a new path, and its movement fails if it gets stuck again.
+	 *
+	 * @param WorldContextObject The world context object.
+	 * @param Controllers The controllers to move.
+	 * @param Destination The vector location to move to. This is the front center of the formation.
+	 * @param FormationSpacing The distance between the controllers in the formation.
+	 * @param AcceptanceRadius The radius around each formation slot that is considered acceptable.
+	 * @param bCheckStuckMovement Check if the controllers get stuck while moving.
+	 * @param StuckThreshold The distance threshold to consider a controller stuck.
+	 * @param MaxSharedPathDistance Controllers farther than this from the controller finding the group path, the one closest to the middle of the group, find their own path instead of sharing it.
+	 * @param bDebugLineTrace Display a line trace to the destination location for a short duration.
+	 * @param bUseAsyncPathfinding Find the group path and the controllers' own paths asynchronously instead of on the game thread. Recommended for large groups.
+	 */
+	UFUNCTION(
+		BlueprintCallable,
+		meta=(
+			BlueprintInternalUseOnly = "true",
+			Category = "Unreal Directive|AI|Navigation",
+			WorldContext = "WorldContextObject",
+			DisplayName = "Async Group Move To Location",
+			AdvancedDisplay=5
+			))
+	static UUDAT_GroupMoveToLocation* GroupMoveToLocation(
+		UObject* WorldContextObject,
+		const TArray<AController*>& Controllers,
+		FVector Destination,
+		float FormationSpacing = 150.0f,
+		float AcceptanceRadius = 100.0f,
+		bool bCheckStuckMovement = true,
+		float StuckThreshold = 1.0f,
+		float MaxSharedPathDistance = 1000.0f,
+		bool bDebugLineTrace = false,
+		bool bUseAsyncPathfinding = false);
+
+	/**
+	 * Ends the async action, stopping the movement of every controller still moving.
+	 * This must be called manually when the task is no longer necessary.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "UDCore|AI|Navigation")
+	void EndTask();
+	virtual void Activate() override;
+
+	// IUDCorePoolableLatentAction
+	virtual void ResetForPool() override;
+
+	// The delegate called when the movement of a controller has completed regardless of success.
+	UPROPERTY(BlueprintAssignable)
+	FOnAsyncGroupMemberMoveToLocation MemberCompleted;
+
+	// The delegate called when the movement of every controller has completed. Succeeds only if every controller arrived.
+	UPROPERTY(BlueprintAssignable)
+	FOnAsyncGroupMoveToLocation Completed;
+
+protected:
+
+	// The cached controllers to move.
+	UPROPERTY()
+	TArray<AController*> Controllers;
+
+	// The cached data
+	FVector Destination;
+	float FormationSpacing = 150.0f;
+	float AcceptanceRadius = 100.0f;
+	bool bCheckStuckMovement = true;
+	float StuckThreshold = 1.0f;
+	float MaxSharedPathDistance = 1000.0f;
+	bool bDebugLineTrace;
+	bool bUseAsyncPathfinding = false;
+
+	/* The move subsystem of the controllers' world. */
+	TWeakObjectPtr<UUDCoreMoveSubsystem> MoveSubsystem;
+
+	/* The handles of the move requests tracked by the move subsystem, in the order of the controllers. */
+	TArray<FUDMoveRequestHandle> MoveHandles;
+
+	/* The number of controllers still moving. */
+	int32 NumMoving = 0;
+
+	/* The number of controllers that have failed to arrive. */
+	int32 NumFailed = 0;
+
+	/** Called by the move subsystem when the move request of a controller has completed. */
+	void OnMemberMoveRequestCompleted(FUDMoveRequestHandle Handle, bool bSuccess);
+
+	/* True until the action has completed. A completed action may be reused by the latent action pool. */
+	bool bActive = false;
+
+	/* Called at completion of movement of every controller. */
+	virtual void ExecuteCompleted(bool bSuccess);
+};
@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintAsyncActionBase.h"
 #include "GameFramework/Controller.h"
+#include "AI/UDCoreMoveSubsystem.h"
+#include "Subsystems/UDCoreLatentActionPool.h"
 #include "UDAT_MoveToLocation.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAsyncMoveToLocation, bool, bSuccess);
@@ -12,9 +14,10 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAsyncMoveToLocation, bool, bSucce
 /**
  * UDAT_MoveToLocation
  * Asynchronously moves an actor to a location.
+ * The movement is tracked by the UUDCoreMoveSubsystem of the controller's world, this action only holds the request handle.
  */
 UCLASS(BlueprintType, meta=(ExposedAsyncProxy = AsyncTask, DisplayName="Async Move To Location"))
-class UDCORE_API UUDAT_MoveToLocation : public UBlueprintAsyncActionBase
+class UDCORE_API UUDAT_MoveToLocation : public UBlueprintAsyncActionBase, public IUDCorePoolableLatentAction
 {
 	GENERATED_BODY()
 
@@ -25,7 +28,7 @@ public:
 	 * When the movement has succeeded or failed, the Completed delegate is called with success/failure.
 	 *
 	 * If the controller or pawn is destroyed while moving, the task will automatically end.
-	 * If bCheckStuckMovement is enabled and the controller gets stuck while moving, the task will automatically end.
+	 * If bCheckStuckMovement is enabled and the controller gets stuck while moving, a new path is found, and the task will automatically end if it gets stuck again.
 	 *
 	 * @param WorldContextObject The world context object.
 	 * @param Controller The controller to move.
@@ -34,6 +37,7 @@ public:
 	 * @param bCheckStuckMovement Check if the controller gets stuck while moving.
 	 * @param StuckThreshold The distance threshold to consider the controller stuck.
 	 * @param bDebugLineTrace Display a line trace to the destination location for a short duration.
+	 * @param bUseAsyncPathfinding Find the path asynchronously instead of on the game thread. Recommended when many controllers start moving in the same frame.
 	 */
 	UFUNCTION(
 		BlueprintCallable,
@@ -51,7 +55,46 @@ public:
 		float AcceptanceRadius = 100.0f,
 		bool bCheckStuckMovement = true,
 		float StuckThreshold = 1.0f,
-		bool bDebugLineTrace = false);
+		bool bDebugLineTrace = false,
+		bool bUseAsyncPathfinding = false);
+
+	/**
+	 * Moves the actor to the target actor, following it while it moves.
+	 * When the controller has reached the target actor or failed to, the Completed delegate is called with success/failure.
+	 *
+	 * The path is only extended once the target actor has moved past RepathDistance, and controllers following the same
+	 * target actor share that work, so many controllers can chase the same actor cheaply.
+	 * If the controller, pawn or target actor is destroyed while moving, the task will automatically end.
+	 *
+	 * @param WorldContextObject The world context object.
+	 * @param Controller The controller to move.
+	 * @param TargetActor The actor to follow.
+	 * @param AcceptanceRadius The radius around the target actor that is considered acceptable.
+	 * @param RepathDistance The distance the target actor must move before the path is extended towards it.
+	 * @param bCheckStuckMovement Check if the controller gets stuck while moving.
+	 * @param StuckThreshold The distance threshold to consider the controller stuck.
+	 * @param bDebugLineTrace Display a line trace to the target actor location for a short duration.
+	 * @param bUseAsyncPathfinding Find the first path asynchronously instead of on the game thread.
+	 */
+	UFUNCTION(
+		BlueprintCallable,
+		meta=(
+			BlueprintInternalUseOnly = "true",
+			Category = "Unreal Directive|AI|Navigation",
+			WorldContext = "WorldContextObject",
+			DisplayName = "Async Follow Actor",
+			AdvancedDisplay=5
+			))
+	static UUDAT_MoveToLocation* FollowActor(
+		UObject* WorldContextObject,
+		AController* Controller,
+		AActor* TargetActor,
+		float AcceptanceRadius = 100.0f,
+		float RepathDistance = 200.0f,
+		bool bCheckStuckMovement = true,
+		float StuckThreshold = 1.0f,
+		bool bDebugLineTrace = false,
+		bool bUseAsyncPathfinding = false);
 
 	/**
 	 * Ends the async action.
@@ -61,6 +104,9 @@ public:
 	void EndTask();
 	virtual void Activate() override;
 
+	// IUDCorePoolableLatentAction
+	virtual void ResetForPool() override;
+
 	// The delegate called when the movement has completed regardless of success.
 	UPROPERTY(BlueprintAssignable)
 	FOnAsyncMoveToLocation Completed;
@@ -73,25 +119,25 @@ protected:
 	
 	// The cached data
 	FVector Destination;
-	FVector StartLocation;
-	FVector CurrentLocation;
-	FVector LastCheckedLocation;
 	float AcceptanceRadius = 10.0f;
 	bool bCheckStuckMovement = true;
 	float StuckThreshold = 1.0f;
 	bool bDebugLineTrace;
+	bool bUseAsyncPathfinding = false;
 
-	/* The timer handle to check for completed movement. */
-	FTimerHandle TimerHandle;
+	/* The actor to follow, if the task follows an actor instead of moving to a fixed location. */
+	bool bFollowTargetActor = false;
+	TWeakObjectPtr<AActor> TargetActor;
+	float RepathDistance = 200.0f;
 
-	/* The timer handle to check for stuck movement. */
-	FTimerHandle StuckTimerHandle;
+	/* The handle of the move request tracked by the move subsystem. */
+	FUDMoveRequestHandle MoveHandle;
 
-	/** Handles the movement to the destination. */
-	void CheckMoveToLocation();
+	/** Called by the move subsystem when the move request has completed. */
+	void OnMoveRequestCompleted(FUDMoveRequestHandle Handle, bool bSuccess);
 
-	/** Handles the stuck movement. */
-	void CheckStuckMovement();
+	/* True until the action has completed. A completed action may be reused by the latent action pool. */
+	bool bActive = false;
 
 	/* Called at completion of movement to destination. */
 	virtual void ExecuteCompleted(bool bSuccess);
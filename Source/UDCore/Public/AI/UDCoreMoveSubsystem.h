@@ -0,0 +1,450 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AI/Navigation/NavigationTypes.h"
+#include "Containers/StaticArray.h"
+#include "UObject/ObjectKey.h"
+#include "UDCoreMoveSubsystem.generated.h"
+
+class AActor;
+class AController;
+class ANavigationData;
+
+/**
+ * Identifies a move request owned by the UUDCoreMoveSubsystem.
+ */
+struct UDCORE_API FUDMoveRequestHandle
+{
+	FUDMoveRequestHandle() = default;
+	explicit FUDMoveRequestHandle(const uint32 InId) : Id(InId) {}
+
+	/** Returns true if the handle was issued by the move subsystem. It may still refer to a completed request. */
+	bool IsValid() const { return Id != 0; }
+
+	/** Resets the handle so it no longer refers to a request. */
+	void Invalidate() { Id = 0; }
+
+	bool operator==(const FUDMoveRequestHandle& Other) const { return Id == Other.Id; }
+	bool operator!=(const FUDMoveRequestHandle& Other) const { return Id != Other.Id; }
+	friend uint32 GetTypeHash(const FUDMoveRequestHandle& Handle) { return Handle.Id; }
+
+	uint32 Id = 0;
+};
+
+/**
+ * The parameters of a move request.
+ */
+struct UDCORE_API FUDMoveRequestParams
+{
+	/** The location to move to. */
+	FVector Destination = FVector::ZeroVector;
+
+	/** The radius around the destination that is considered as arrived. */
+	float AcceptanceRadius = 100.0f;
+
+	/** Fail the request if the controller stops making progress. */
+	bool bCheckStuckMovement = true;
+
+	/**
+	 * The progress along the path the controller must make over the stuck detection window to not be considered stuck.
+	 * The window length is set by the UDCore.Move.StuckDetectionLatency console variable.
+	 */
+	float StuckThreshold = 1.0f;
+
+	/**
+	 * Find the path with an asynchronous navigation query instead of on the game thread.
+	 * The queries are rate limited by the UDCore.Move.MaxPathQueriesPerFrame console variable.
+	 */
+	bool bUseAsyncPathfinding = false;
+
+	/**
+	 * The actor to follow. When set, the destination follows the actor's location.
+	 * Every request following the same actor shares its repaths, which only extend the current paths once the actor has moved past RepathDistance.
+	 */
+	TWeakObjectPtr<AActor> TargetActor;
+
+	/** The distance the target actor must move away from the end of the current path before the path is extended. */
+	float RepathDistance = 200.0f;
+
+	/**
+	 * Allow the request to switch to low fidelity movement while the controller is far from every player and not rendered.
+	 * Low fidelity movement is enabled by the UDCore.Move.LowFidelityDistance console variable.
+	 */
+	bool bAllowLowFidelity = true;
+};
+
+/**
+ * The work done by the move subsystem during the last frame.
+ */
+struct UDCORE_API FUDMoveSchedulerStats
+{
+	/** The number of move requests checked. */
+	int32 NumChecks = 0;
+
+	/** The number of due move requests pushed to the next frame because the frame budget was spent. */
+	int32 NumDeferred = 0;
+
+	/** The time spent checking move requests, in microseconds. */
+	double ElapsedMicroseconds = 0.0;
+};
+
+/**
+ * The telemetry of a move request.
+ */
+struct UDCORE_API FUDMoveRequestTelemetry
+{
+	/** The world time the request was made at. */
+	double StartTime = 0.0;
+
+	/** The length of the last path given to the controller, or 0 if it is unknown. */
+	float PathLength = 0.0f;
+
+	/** The distance the controller has travelled, measured at each check. */
+	float TravelledDistance = 0.0f;
+
+	/** The number of times a new path was found or the path was extended. */
+	uint16 NumRepaths = 0;
+
+	/** The number of times the controller was detected as stuck. */
+	uint16 NumStuckEvents = 0;
+};
+
+/** Called once when a move request has completed, successfully or not. */
+DECLARE_DELEGATE_TwoParams(FOnUDMoveRequestCompleted, FUDMoveRequestHandle /*Handle*/, bool /*bSuccess*/);
+
+/**
+ * UDCoreMoveSubsystem
+ *
+ * Owns every active move request of a world and checks their arrival and stuck state in one batched tick.
+ * Requests are stored in contiguous arrays so a crowd of agents costs one pass over memory instead of two timers per agent.
+ *
+ * Each request is checked again after an interval derived from its distance to the destination and its speed,
+ * so agents close to arriving are checked often and distant agents rarely. The checks of a frame are bounded by
+ * the UDCore.Move.FrameBudgetUs console variable, requests that do not fit are checked first on the next frame.
+ *
+ * Requests following an actor are grouped by target. When the target has moved far enough, one path query from the
+ * previous goal to the new one is shared by every follower and spliced onto the part of their path they have not walked yet.
+ *
+ * Stuck detection keeps a small ring buffer of recent positions per request. A request whose controller makes no
+ * progress along its path, or keeps moving back and forth, is repathed a limited number of times before failing.
+ */
+UCLASS()
+class UDCORE_API UUDCoreMoveSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Moves the controller to the destination and tracks the movement until it arrives, gets stuck or is cancelled.
+	 * @param Controller The controller to move.
+	 * @param Params The parameters of the move.
+	 * @param OnCompleted Called once when the move has succeeded or failed. Not called if the move is cancelled.
+	 * @returns The handle of the move request, or an invalid handle if the controller has no pawn.
+	 */
+	FUDMoveRequestHandle RequestMove(AController* Controller, const FUDMoveRequestParams& Params, FOnUDMoveRequestCompleted&& OnCompleted);
+
+	/**
+	 * Moves a group of controllers to the destination using a single path query.
+	 * The controller closest to the middle of the group finds the path, every member follows it to its own formation slot.
+	 * The path query is asynchronous if Params.bUseAsyncPathfinding is set, the members start moving once it has finished.
+	 * The slots are laid out in rows behind the destination, facing the direction the path arrives from.
+	 * Members farther than MaxSharedPathDistance from that controller, or whose way onto or off the shared path is blocked
+	 * on the navmesh, find their own path asynchronously.
+	 * @param GroupControllers The controllers to move.
+	 * @param Params The parameters of the move. The destination is the front center of the formation.
+	 * @param FormationSpacing The distance between two formation slots.
+	 * @param MaxSharedPathDistance The maximum distance between a member and the controller finding the path for it to follow the shared path.
+	 * @param OnCompleted Called once for every member when its move has succeeded or failed.
+	 * @returns The handles of the move requests, in the order of the controllers. Controllers without a pawn get an invalid handle.
+	 */
+	TArray<FUDMoveRequestHandle> RequestGroupMove(
+		const TArray<AController*>& GroupControllers,
+		const FUDMoveRequestParams& Params,
+		float FormationSpacing,
+		float MaxSharedPathDistance,
+		const FOnUDMoveRequestCompleted& OnCompleted);
+
+	/**
+	 * Stops tracking the move request without calling its completion delegate.
+	 * @param Handle The handle of the move request.
+	 * @returns True if the request was still active.
+	 */
+	bool CancelMove(FUDMoveRequestHandle Handle);
+
+	/** Returns true if the move request is still active. */
+	bool IsMoveActive(const FUDMoveRequestHandle Handle) const { return HandleToIndex.Contains(Handle); }
+
+	/** Returns the number of active move requests. */
+	int32 GetNumActiveMoves() const { return Handles.Num(); }
+
+	/**
+	 * Returns the telemetry of the move request, or nullptr if it is not active.
+	 * The pointer is only valid until the next tick of the move subsystem.
+	 */
+	const FUDMoveRequestTelemetry* GetMoveTelemetry(FUDMoveRequestHandle Handle) const;
+
+	/**
+	 * Returns the active move request of the controller, or an invalid handle if it has none.
+	 * This goes through every active request and is meant for debugging tools.
+	 */
+	FUDMoveRequestHandle FindMoveRequest(const AController* Controller) const;
+
+	/** Returns the destination and acceptance radius of the move request. Returns false if it is not active. */
+	bool GetMoveDestination(FUDMoveRequestHandle Handle, FVector& OutDestination, float& OutAcceptanceRadius) const;
+
+	/** Returns the number of move requests currently moving at low fidelity. */
+	int32 GetNumLowFidelityMoves() const { return NumLowFidelityMoves; }
+
+	/** Returns the work done by the move subsystem during the last frame. */
+	const FUDMoveSchedulerStats& GetLastFrameStats() const { return LastFrameStats; }
+
+	// UTickableWorldSubsystem
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+
+	/** The recent positions of a move request, used to detect stuck and oscillating controllers. */
+	struct FMoveHistory
+	{
+		static constexpr int32 NumSamples = 8;
+
+		/** Adds a sample, overwriting the oldest one once the buffer is full. */
+		void Add(const FVector& Location, float RemainingDistance);
+
+		/** Clears the samples. */
+		void Reset() { Head = 0; Num = 0; }
+
+		/**
+		 * Returns true if the samples show no progress along the path, or mostly back and forth movement.
+		 * Always false until the buffer is full.
+		 */
+		bool IsStuck(float StuckThreshold, float OscillationRatio) const;
+
+		/** Returns the progress along the path between the two newest samples, or 0 until there are two samples. */
+		float GetLastProgress() const
+		{
+			if (Num < 2) { return 0.0f; }
+			return RemainingDistances[(Head + NumSamples - 2) % NumSamples] - RemainingDistances[(Head + NumSamples - 1) % NumSamples];
+		}
+
+		TStaticArray<FVector, NumSamples> Locations;
+		TStaticArray<float, NumSamples> RemainingDistances;
+		int32 Head = 0;
+		int32 Num = 0;
+	};
+
+	/** A group move waiting for the path its members share. */
+	struct FGroupMove
+	{
+		/** The handles of the requests of the members. */
+		TArray<FUDMoveRequestHandle> Members;
+
+		/** The front center of the formation. */
+		FVector Destination = FVector::ZeroVector;
+
+		/** The navigation location of the member finding the shared path when it was requested. */
+		FVector LeaderLocation = FVector::ZeroVector;
+
+		float FormationSpacing = 0.0f;
+		float MaxSharedPathDistance = 0.0f;
+
+		/** The navigation data and filter of the shared path query, used to project the slots and validate the joining segments. */
+		TWeakObjectPtr<const ANavigationData> NavigationData;
+		FSharedConstNavQueryFilter QueryFilter;
+	};
+
+	/** The state shared by every move request following the same actor. */
+	struct FFollowTarget
+	{
+		TWeakObjectPtr<AActor> Actor;
+
+		/** The location the paths of the followers currently end at. */
+		FVector Goal = FVector::ZeroVector;
+
+		/** The location of the actor when the goal was found. */
+		FVector GoalActorLocation = FVector::ZeroVector;
+
+		/** The location of the actor when the extension query in flight was sent. */
+		FVector ExtensionActorLocation = FVector::ZeroVector;
+
+		/** The handles of the requests following the actor. */
+		TArray<FUDMoveRequestHandle> Followers;
+
+		/** The id of the path query extending the paths from the goal to the actor, or 0 if none is in flight. */
+		uint32 ExtensionQueryId = 0;
+
+		/** True if a follower has found that the actor moved past its repath distance. */
+		bool bNeedsRepath = false;
+	};
+
+	/**
+	 * The state of a move request moving at low fidelity.
+	 * The path following and movement components of the pawn are paused, and the pawn is placed along the path corridor at each check.
+	 */
+	struct FLowFidelityMove
+	{
+		/** The path the pawn is placed along, or null while the request moves at full fidelity. */
+		FNavPathSharedPtr Corridor;
+
+		/** The index of the corridor point the pawn is heading to. */
+		int32 NextPoint = 0;
+
+		/** The world time the pawn was last placed along the corridor. */
+		double LastStepTime = 0.0;
+
+		/** The speed the pawn moves along the corridor at. */
+		float Speed = 0.0f;
+
+		/** The height of the pawn location above its navigation location. */
+		float HeightOffset = 0.0f;
+
+		/** False if the request opted out of low fidelity movement. */
+		bool bAllowed = true;
+
+		bool IsActive() const { return Corridor.IsValid(); }
+	};
+
+	/**
+	 * Checks the arrival and stuck state of a batch of due move requests and schedules their next check.
+	 * @param Indices The indices of the requests to check.
+	 * @param CurrentTime The current world time.
+	 * @param OutCompleted The handles and success of the requests that have completed.
+	 */
+	void CheckMoveRequests(TConstArrayView<int32> Indices, double CurrentTime, TArray<TPair<FUDMoveRequestHandle, bool>>& OutCompleted);
+
+	/** Adds a move request for the controller without starting its movement. */
+	FUDMoveRequestHandle AddMoveRequest(AController& Controller, const FUDMoveRequestParams& Params, FOnUDMoveRequestCompleted&& OnCompleted);
+
+	/** Holds the checks of the move request until its asynchronous path query has been sent and has finished. */
+	void QueuePathQuery(FUDMoveRequestHandle Handle);
+
+	/**
+	 * Makes the controller of the move request follow the path and starts its checks.
+	 * @returns False if the path following component refused the path.
+	 */
+	bool FollowPath(int32 Index, const FNavPathSharedPtr& Path);
+
+	/**
+	 * Switches the requests between low and full fidelity from the distance of their pawn to the player viewpoints and whether it was recently rendered.
+	 * Runs at the interval set by the UDCore.Move.SignificanceInterval console variable.
+	 */
+	void UpdateSignificance(double CurrentTime);
+
+	/** Pauses the path following and movement of the controller of the move request and starts placing its pawn along the path corridor. */
+	void EnterLowFidelity(int32 Index, double CurrentTime);
+
+	/**
+	 * Gives the movement of the controller of the move request back to its path following and movement components.
+	 * @param bRepath Find a new path from the current location of the pawn. Otherwise the paused move is aborted.
+	 */
+	void ExitLowFidelity(int32 Index, bool bRepath);
+
+	/**
+	 * Places the pawn of the move request where it would be along the path corridor.
+	 * @returns False if the pawn has reached the end of the corridor.
+	 */
+	bool StepLowFidelity(int32 Index, double CurrentTime);
+
+	/**
+	 * Gives every member of the group its formation slot and makes the members near the leader follow the shared path to it.
+	 * The other members, and every member if there is no shared path, find their own path asynchronously.
+	 */
+	void AssignGroupPaths(const FGroupMove& GroupMove, FNavPathSharedPtr SharedPath);
+
+	/** Called by the navigation system when the asynchronous path query shared by a group has finished. */
+	void OnGroupPathQueryFinished(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+
+	/** Sends one path query per followed actor that has moved past the repath distance of one of its followers. */
+	void RepathFollowTargets();
+
+	/** Called by the navigation system when the path query extending the paths of the followers of an actor has finished. */
+	void OnExtensionQueryFinished(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+
+	/**
+	 * Makes the follower continue its current path up to the previous goal, then along the extension.
+	 * @returns False if the follower has no path left to extend, its path does not end at the previous goal,
+	 * the segment joining the extension is blocked, or the extension would make it walk back.
+	 */
+	bool SpliceFollowPath(int32 Index, const FVector& PreviousGoal, const FNavPathSharedPtr& Extension);
+
+	/** Sends the queued asynchronous path queries allowed this frame. */
+	void DispatchPathQueries();
+
+	/** Called by the navigation system when an asynchronous path query has finished. */
+	void OnPathQueryFinished(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+
+	/** Records the completion of the move request at the provided index in the UDCoreMove trace channel. */
+	void TraceMoveCompleted(int32 Index, bool bSuccess) const;
+
+	/** Removes the move request and calls its completion delegate. */
+	void FinishMoveRequest(FUDMoveRequestHandle Handle, bool bSuccess);
+
+	/** Removes the move request at the provided index, keeping the arrays contiguous. */
+	void RemoveMoveRequestAt(int32 Index);
+
+	// The active move requests, stored as parallel arrays indexed together.
+	TArray<FUDMoveRequestHandle> Handles;
+	TArray<TWeakObjectPtr<AController>> Controllers;
+	TArray<FVector> Destinations;
+	TArray<FVector> LastCheckedLocations;
+	TArray<float> AcceptanceRadii;
+	TArray<float> StuckThresholds;
+	TArray<double> NextCheckTimes;
+	TArray<double> NextStuckSampleTimes;
+	TArray<FMoveHistory> Histories;
+	TArray<uint8> RepathCounts;
+	TArray<FUDMoveRequestTelemetry> Telemetry;
+	TArray<bool> AwaitingPaths;
+	TArray<FObjectKey> FollowTargetKeys;
+	TArray<float> RepathDistancesSquared;
+	TArray<FLowFidelityMove> LowFidelityMoves;
+	TArray<FOnUDMoveRequestCompleted> CompletedDelegates;
+
+	/** Maps the handle of each active request to its index in the request arrays. */
+	TMap<FUDMoveRequestHandle, int32> HandleToIndex;
+
+	/** The move requests waiting for their asynchronous path query to be sent, in request order. */
+	TArray<FUDMoveRequestHandle> QueuedPathQueries;
+
+	/** Maps the id of each asynchronous path query in flight to its move request. */
+	TMap<uint32, FUDMoveRequestHandle> PathQueries;
+
+	/** The actors followed by move requests. */
+	TMap<FObjectKey, FFollowTarget> FollowTargets;
+
+	/** Maps the id of each asynchronous group path query in flight to its group. */
+	TMap<uint32, FGroupMove> GroupPathQueries;
+
+	/** Maps the id of each extension path query in flight to its followed actor. */
+	TMap<uint32, FObjectKey> ExtensionQueries;
+
+	/** Scratch storage reused by every batch. */
+	TArray<FVector> CurrentLocations;
+	TArray<float> CurrentSpeeds;
+
+	/** The index the next frame starts looking for due requests from, so deferred requests are checked first. */
+	int32 ScanCursor = 0;
+
+	/** The number of requests moving at low fidelity. */
+	int32 NumLowFidelityMoves = 0;
+
+	/** The world time the significance of the requests is next updated at. */
+	double NextSignificanceTime = 0.0;
+
+	/** The work done during the last frame. */
+	FUDMoveSchedulerStats LastFrameStats;
+
+	/** The id given to the next move request. */
+	uint32 NextRequestId = 1;
+};
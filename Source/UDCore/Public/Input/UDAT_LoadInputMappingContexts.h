@@ -0,0 +1,120 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "Types/UDCoreInputTypes.h"
+#include "UDAT_LoadInputMappingContexts.generated.h"
+
+class AController;
+class UInputMappingContext;
+struct FStreamableHandle;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAsyncInputMappingContexts, bool, bSuccess);
+
+/**
+ * UDAT_LoadInputMappingContexts
+ * Streams Input Mapping Contexts in one batched asynchronous request, then adds, removes or swaps them once they are loaded.
+ * Use these instead of the UUDCoreInputFunctionLibrary functions when the contexts may not be loaded yet, to avoid a hitch on the game thread.
+ */
+UCLASS(BlueprintType, meta=(ExposedAsyncProxy = AsyncTask))
+class UDCORE_API UUDAT_LoadInputMappingContexts : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Loads and applies multiple Input Mapping Contexts.
+	 * @param PlayerController The player controller to add the contexts to. Will attempt to get the LocalPlayer from the controller.
+	 * @param Contexts The contexts to apply.
+	 * @param bClearPrevious Whether to clear all previous contexts before applying the new ones.
+	 */
+	UFUNCTION(
+		BlueprintCallable,
+		meta=(
+			BlueprintInternalUseOnly = "true",
+			Category = "Unreal Directive|Input",
+			DefaultToSelf = "PlayerController",
+			DisplayName = "Async Add Input Mapping Contexts"
+			))
+	static UUDAT_LoadInputMappingContexts* AddInputMappingContextsAsync(
+		AController* PlayerController,
+		const TArray<FUDCoreEnhancedInputContextData>& Contexts,
+		bool bClearPrevious);
+
+	/**
+	 * Removes multiple Input Mapping Contexts without loading them.
+	 * Contexts that are not loaded cannot be applied, so they are skipped instead of being streamed in.
+	 * @param PlayerController The player controller to remove the contexts from. Will attempt to get the LocalPlayer from the controller.
+	 * @param Contexts The contexts to remove.
+	 */
+	UFUNCTION(
+		BlueprintCallable,
+		meta=(
+			BlueprintInternalUseOnly = "true",
+			Category = "Unreal Directive|Input",
+			DefaultToSelf = "PlayerController",
+			DisplayName = "Async Remove Input Mapping Contexts"
+			))
+	static UUDAT_LoadInputMappingContexts* RemoveInputMappingContextsAsync(
+		AController* PlayerController,
+		const TArray<TSoftObjectPtr<UInputMappingContext>>& Contexts);
+
+	/**
+	 * Loads both Input Mapping Contexts, then swaps the previous one with the new one.
+	 * @param PlayerController The player controller to swap the contexts on. Will attempt to get the LocalPlayer from the controller.
+	 * @param PreviousContext The context to swap out.
+	 * @param NewContext The context to swap in.
+	 * @param Priority The priority to set the new context to.
+	 * @param bUsePreviousPriority Whether to use the previous context's priority when adding the new context.
+	 */
+	UFUNCTION(
+		BlueprintCallable,
+		meta=(
+			BlueprintInternalUseOnly = "true",
+			Category = "Unreal Directive|Input",
+			DefaultToSelf = "PlayerController",
+			DisplayName = "Async Swap Input Mapping Contexts"
+			))
+	static UUDAT_LoadInputMappingContexts* SwapInputMappingContextsAsync(
+		AController* PlayerController,
+		TSoftObjectPtr<UInputMappingContext> PreviousContext,
+		TSoftObjectPtr<UInputMappingContext> NewContext,
+		int32 Priority,
+		bool bUsePreviousPriority);
+
+	virtual void Activate() override;
+
+	// The delegate called once the contexts have been loaded and applied, or have failed to.
+	UPROPERTY(BlueprintAssignable)
+	FOnAsyncInputMappingContexts Completed;
+
+protected:
+
+	enum class EOperation : uint8
+	{
+		Add,
+		Remove,
+		Swap,
+	};
+
+	/* The cached data */
+	EOperation Operation = EOperation::Add;
+	TWeakObjectPtr<AController> PlayerController;
+	TArray<FUDCoreEnhancedInputContextData> Contexts;
+	bool bClearPrevious = false;
+	bool bUsePreviousPriority = false;
+
+	/* The handle keeping the contexts loaded until they are applied. */
+	TSharedPtr<FStreamableHandle> LoadHandle;
+
+	/** Called by the streamable manager once every context has been loaded. */
+	void OnContextsLoaded();
+
+	/** Applies the loaded contexts and completes the task. */
+	void ApplyContexts();
+
+	void ExecuteCompleted(bool bSuccess);
+};
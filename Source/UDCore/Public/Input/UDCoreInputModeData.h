@@ -0,0 +1,55 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Types/UDCoreInputTypes.h"
+#include "UDCoreInputModeData.generated.h"
+
+class UInputMappingContext;
+
+/**
+ * UDCoreInputModeData
+ * An input mode, such as gameplay, vehicle or menu, described by the Input Mapping Contexts it applies.
+ * Modes are pushed on and popped from the UUDCoreInputModeSubsystem of a local player.
+ */
+UCLASS(BlueprintType)
+class UDCORE_API UUDCoreInputModeData : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	/** The contexts applied while the mode is active. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input")
+	TArray<FUDCoreEnhancedInputContextData> Contexts;
+
+	/** Whether the modes below this one on the stack stop applying their contexts, for example for a full screen menu. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input")
+	bool bBlocksLowerModes = false;
+
+	/**
+	 * Resolves the contexts of the mode once, loading them synchronously if they are not loaded yet.
+	 * Preload the contexts with the UUDCoreInputContextPreloader to keep the first push free of loads.
+	 */
+	void ResolveContexts();
+
+	/** Returns the resolved contexts of the mode, in the order of Contexts. Empty until ResolveContexts has been called. */
+	TConstArrayView<TObjectPtr<const UInputMappingContext>> GetResolvedContexts() const { return ResolvedContexts; }
+
+	/** Returns the priorities of the resolved contexts. */
+	TConstArrayView<int32> GetResolvedPriorities() const { return ResolvedPriorities; }
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+
+	/** The loaded contexts and their priorities, without the contexts that failed to load. */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<const UInputMappingContext>> ResolvedContexts;
+	TArray<int32> ResolvedPriorities;
+	bool bContextsResolved = false;
+};
@@ -22,6 +22,7 @@ public:
 	
 	/**
 	* Apply multiple Input Mapping Contexts.
+	* Contexts that are not loaded yet are loaded synchronously. Use Async Add Input Mapping Contexts or preload them to avoid a hitch.
 	* @param PlayerController The player controller to add the contexts to. Will attempt to get the LocalPlayer from the controller.
 	* @param Contexts The contexts to apply.
 	* @param bClearPrevious Whether to clear all previous contexts before applying the new ones.
@@ -35,6 +36,7 @@ public:
 	
 	/**
 	 * Remove multiple Input Mapping Contexts.
+	 * Contexts that are not loaded yet are loaded synchronously. Use Async Remove Input Mapping Contexts to avoid a hitch.
 	 * @param PlayerController The player controller to remove the contexts from. Will attempt to get the LocalPlayer from the controller.
 	 * @param Contexts The contexts to remove.
 	 * @returns Returns Success if the contexts were successfully removed.
@@ -48,6 +50,7 @@ public:
 	* Swap a designated Input Mapping Context with a new one.
 	* If the previous context is found, it will be removed and the new context will be added.
 	* If the previous context is not found, the new context will be added at the specified priority.
+	* Contexts that are not loaded yet are loaded synchronously. Use Async Swap Input Mapping Contexts or preload them to avoid a hitch.
 	* @param PlayerController The player controller to swap the contexts on. Will attempt to get the LocalPlayer from the controller.
 	* @param PreviousContext The context to swap out.
 	* @param NewContext The context to swap in.
@@ -63,6 +66,34 @@ public:
 		int32 Priority,
 		bool bUsePreviousPriority);
 
+	/**
+	 * Make the applied Input Mapping Contexts match the provided set, only adding, re-prioritizing or removing the contexts that differ.
+	 * Every change is made with a deferred control mappings rebuild, so the whole set costs a single rebuild.
+	 * Contexts that are not loaded yet are loaded synchronously. Preload them to avoid a hitch.
+	 * @param PlayerController The player controller to apply the contexts to. Will attempt to get the LocalPlayer from the controller.
+	 * @param Contexts The contexts that should be applied, with their priority.
+	 * @param bRemoveOthers Whether to remove the applied contexts that are not part of the set.
+	 * @param bIgnoreAllPressedKeysUntilRelease Whether keys held while the contexts change are ignored until they are released.
+	 * @param bForceImmediately Whether to rebuild the control mappings right away instead of at the end of the frame.
+	 * @returns Returns Success if the set was applied.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "UDCore|Input", meta=(ExpandEnumAsExecs="ReturnValue", DefaultToSelf="PlayerController", AdvancedDisplay="bIgnoreAllPressedKeysUntilRelease,bForceImmediately"))
+	static EUDSuccessStatus ApplyInputMappingContextSet(
+		AController* PlayerController,
+		const TArray<FUDCoreEnhancedInputContextData>& Contexts,
+		bool bRemoveOthers = true,
+		bool bIgnoreAllPressedKeysUntilRelease = true,
+		bool bForceImmediately = false);
+
+	/**
+	 * Returns the Enhanced Input Subsystem of the local player of the controller, or nullptr if it has none.
+	 * A controller that is not a player controller, such as an AI controller, resolves through the player controller
+	 * owning its pawn, or owning the controller itself.
+	 * @param Controller The controller to get the subsystem of.
+	 */
+	UFUNCTION(BlueprintPure, Category = "UDCore|Input", meta=(DefaultToSelf="Controller"))
+	static UEnhancedInputLocalPlayerSubsystem* FindEnhancedInputSubsystem(const AController* Controller);
+
 protected:
 	/**
 	 * Attempt to get the Enhanced Input Subsystem from the provided controller.
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Types/UDCoreTypes.h"
+#include "Types/UDCoreStringTypes.h"
 #include "UDCoreStringFunctionLibrary.generated.h"
 
 /**
@@ -50,6 +51,35 @@ public:
 	UFUNCTION(BlueprintPure, Category = "UDCore|String" )
 	static bool ContainsSpecialCharacters(const FString& String);
 
+	/**
+	 * Get the character classes of the provided string and how many characters of each class it holds, in a single pass.
+	 * Prefer this over calling several of the Contains functions on the same string.
+	 * @param String - The string to profile.
+	 * @returns The character profile of the string.
+	 */
+	UFUNCTION(BlueprintPure, Category = "UDCore|String")
+	static FUDCoreCharacterProfile GetCharacterProfile(const FString& String);
+
+	/**
+	 * Detect if the profiled string contains a character of any of the provided classes.
+	 * @param Profile - The character profile of the string.
+	 * @param Classes - The character classes to look for.
+	 * @returns True if the string contains a character of any of the classes.
+	 */
+	UFUNCTION(BlueprintPure, Category = "UDCore|String")
+	static bool CharacterProfileContainsAny(const FUDCoreCharacterProfile& Profile, UPARAM(meta = (Bitmask, BitmaskEnum = "/Script/UDCore.EUDCoreCharacterClass")) const int32 Classes);
+
+	/**
+	 * Detect if every character of the profiled string is in one of the provided classes.
+	 * Non-ASCII letters, digits, whitespace and punctuation only need their own class. Including Non-ASCII also allows
+	 * the non-ASCII characters that are in no other class, such as most symbols.
+	 * @param Profile - The character profile of the string.
+	 * @param Classes - The character classes that are allowed.
+	 * @returns True if the string only contains characters of the classes.
+	 */
+	UFUNCTION(BlueprintPure, Category = "UDCore|String")
+	static bool CharacterProfileContainsOnly(const FUDCoreCharacterProfile& Profile, UPARAM(meta = (Bitmask, BitmaskEnum = "/Script/UDCore.EUDCoreCharacterClass")) const int32 Classes);
+
 	/**
 	 * Filter out characters types from the string.
 	 * @param String - The string to filter.
@@ -60,7 +90,81 @@ public:
 	 */
 	UFUNCTION(BlueprintPure, Category = "UDCore|String" )
 	static FString FilterCharacters(const FString& String, const bool bLetters, const bool bNumbers, const bool bSpecialCharacters, const bool bSpaces);
+
+	/**
+	 * Filter out characters types from the string, modifying it in place without allocating.
+	 * @param String - The string to filter.
+	 * @param bLetters - If true, filter out letters.
+	 * @param bNumbers - If true, filter out numbers.
+	 * @param bSpecialCharacters - If true, filter out special characters.
+	 * @param bSpaces - If true, filter out spaces.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "UDCore|String")
+	static void FilterCharactersInPlace(UPARAM(ref) FString& String, const bool bLetters, const bool bNumbers, const bool bSpecialCharacters, const bool bSpaces);
+
+	/**
+	 * Filter out characters types from the string, appending the kept characters to the string builder.
+	 * @param String - The string to filter.
+	 * @param bLetters - If true, filter out letters.
+	 * @param bNumbers - If true, filter out numbers.
+	 * @param bSpecialCharacters - If true, filter out special characters.
+	 * @param bSpaces - If true, filter out spaces.
+	 * @param OutBuilder - The string builder the kept characters are appended to.
+	 */
+	static void FilterCharacters(FStringView String, const bool bLetters, const bool bNumbers, const bool bSpecialCharacters, const bool bSpaces, TStringBuilderBase<TCHAR>& OutBuilder);
+
+	/**
+	 * Filter out characters types from the string, writing the kept characters to the buffer.
+	 * @param String - The string to filter.
+	 * @param bLetters - If true, filter out letters.
+	 * @param bNumbers - If true, filter out numbers.
+	 * @param bSpecialCharacters - If true, filter out special characters.
+	 * @param bSpaces - If true, filter out spaces.
+	 * @param OutBuffer - The buffer the kept characters are written to. Must hold at least String.Len() characters.
+	 * @returns The number of characters written to the buffer.
+	 */
+	static int32 FilterCharacters(FStringView String, const bool bLetters, const bool bNumbers, const bool bSpecialCharacters, const bool bSpaces, TArrayView<TCHAR> OutBuffer);
 	
+	/**
+	 * Filter out characters types from every string of the array, in parallel.
+	 * @param Strings - The strings to filter.
+	 * @param bLetters - If true, filter out letters.
+	 * @param bNumbers - If true, filter out numbers.
+	 * @param bSpecialCharacters - If true, filter out special characters.
+	 * @param bSpaces - If true, filter out spaces.
+	 * @returns The filtered strings, in the same order as the provided strings.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "UDCore|String|Batch")
+	static TArray<FString> FilterCharactersBatch(const TArray<FString>& Strings, const bool bLetters, const bool bNumbers, const bool bSpecialCharacters, const bool bSpaces);
+
+	/**
+	 * Filter out characters types from every string of the array in place, in parallel and without allocating.
+	 * @param Strings - The strings to filter.
+	 * @param bLetters - If true, filter out letters.
+	 * @param bNumbers - If true, filter out numbers.
+	 * @param bSpecialCharacters - If true, filter out special characters.
+	 * @param bSpaces - If true, filter out spaces.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "UDCore|String|Batch")
+	static void FilterCharactersBatchInPlace(UPARAM(ref) TArray<FString>& Strings, const bool bLetters, const bool bNumbers, const bool bSpecialCharacters, const bool bSpaces);
+
+	/**
+	 * Detect which strings of the array contain a character of any of the provided classes, in parallel.
+	 * @param Strings - The strings to check.
+	 * @param Classes - The character classes to look for.
+	 * @returns For each string, true if it contains a character of any of the classes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "UDCore|String|Batch")
+	static TArray<bool> ContainsCharacterClassesBatch(const TArray<FString>& Strings, UPARAM(meta = (Bitmask, BitmaskEnum = "/Script/UDCore.EUDCoreCharacterClass")) const int32 Classes);
+
+	/**
+	 * Get the character profile of every string of the array, in parallel.
+	 * @param Strings - The strings to profile.
+	 * @returns The character profile of each string, in the same order as the provided strings.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "UDCore|String|Batch")
+	static TArray<FUDCoreCharacterProfile> GetCharacterProfileBatch(const TArray<FString>& Strings);
+
 	/** 
 	* Sort a string array alphabetically.
 	* @param StringArray - The string array to sort.
@@ -71,8 +175,18 @@ public:
 	/** 
 	* Returns a sorted copy of the provided string array.
 	* @param StringArray - The array of strings to sort.
+	* @param SortMode - The ordering to sort the strings by.
 	* @returns A sorted copy of the provided string array.
 	*/
 	UFUNCTION(BlueprintCallable, Category = "UDCore|String")
-	static TArray<FString> GetSortedStringArray(TArray<FString> StringArray);
+	static TArray<FString> GetSortedStringArray(const TArray<FString>& StringArray, const EUDCoreStringSortMode SortMode = EUDCoreStringSortMode::CaseInsensitive);
+
+	/**
+	* Sort a string array in place. The sort is stable, so strings that compare equal keep their order.
+	* Large arrays are sorted in parallel.
+	* @param StringArray - The array of strings to sort.
+	* @param SortMode - The ordering to sort the strings by.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "UDCore|String")
+	static void SortStringArrayInPlace(UPARAM(ref) TArray<FString>& StringArray, const EUDCoreStringSortMode SortMode = EUDCoreStringSortMode::CaseInsensitive);
 };
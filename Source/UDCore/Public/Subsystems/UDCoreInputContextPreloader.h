@@ -0,0 +1,49 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "UDCoreInputContextPreloader.generated.h"
+
+class UInputMappingContext;
+struct FStreamableHandle;
+
+/**
+ * UDCoreInputContextPreloader
+ *
+ * Streams Input Mapping Contexts ahead of time, for example during a loading screen, and keeps them loaded until they are released.
+ * Adding a preloaded context with the UUDCoreInputFunctionLibrary functions does not load anything on the game thread.
+ */
+UCLASS()
+class UDCORE_API UUDCoreInputContextPreloader : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Starts loading the contexts in one batched asynchronous request. Contexts that are already preloaded are skipped.
+	 * @param Contexts The contexts to preload.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "UDCore|Input")
+	void PreloadInputMappingContexts(const TArray<TSoftObjectPtr<UInputMappingContext>>& Contexts);
+
+	/**
+	 * Stops keeping the contexts loaded. Contexts still referenced elsewhere, such as applied ones, stay loaded.
+	 * @param Contexts The contexts to release.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "UDCore|Input")
+	void ReleaseInputMappingContexts(const TArray<TSoftObjectPtr<UInputMappingContext>>& Contexts);
+
+	/** Returns true if every context is loaded. */
+	UFUNCTION(BlueprintPure, Category = "UDCore|Input")
+	bool AreInputMappingContextsLoaded(const TArray<TSoftObjectPtr<UInputMappingContext>>& Contexts) const;
+
+	virtual void Deinitialize() override;
+
+private:
+
+	/** The handles keeping the preloaded contexts loaded. Contexts preloaded together share a handle. */
+	TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> PreloadHandles;
+};
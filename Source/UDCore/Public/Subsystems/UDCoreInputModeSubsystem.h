@@ -0,0 +1,88 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "UDCoreInputModeSubsystem.generated.h"
+
+class UInputMappingContext;
+class UUDCoreInputModeData;
+
+/**
+ * UDCoreInputModeSubsystem
+ *
+ * A stack of input modes per local player. The contexts applied are those of the modes from the top of the stack
+ * down to the first mode blocking the lower ones, with the upper modes winning when two modes share a context.
+ * Pushing or popping a mode only adds and removes the contexts that differ from the ones Enhanced Input has applied,
+ * with a single deferred control mappings rebuild. Contexts applied outside of the stack are left untouched.
+ * The stack is applied again when the player controller changes, so it survives travel and respawns.
+ */
+UCLASS()
+class UDCORE_API UUDCoreInputModeSubsystem : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Pushes the mode on top of the stack and applies its contexts.
+	 * @param InputMode The mode to push.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "UDCore|Input")
+	void PushInputMode(UUDCoreInputModeData* InputMode);
+
+	/**
+	 * Removes the mode from the stack and applies the contexts of the remaining modes.
+	 * @param InputMode The mode to pop. Pops the top mode if not set.
+	 * @returns True if a mode was popped.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "UDCore|Input")
+	bool PopInputMode(UUDCoreInputModeData* InputMode = nullptr);
+
+	/** Pops every mode and removes their contexts. */
+	UFUNCTION(BlueprintCallable, Category = "UDCore|Input")
+	void ClearInputModes();
+
+	/** Returns the mode on top of the stack, or nullptr if the stack is empty. */
+	UFUNCTION(BlueprintPure, Category = "UDCore|Input")
+	UUDCoreInputModeData* GetTopInputMode() const { return Stack.Num() > 0 ? Stack.Last() : nullptr; }
+
+	/** Returns the modes on the stack, from the bottom to the top. */
+	UFUNCTION(BlueprintPure, Category = "UDCore|Input")
+	const TArray<UUDCoreInputModeData*>& GetInputModes() const { return ToRawPtrTArrayUnsafe(Stack); }
+
+	/**
+	 * Applies the contexts of the stack again, adding back any that were removed outside of the stack.
+	 * Call this after clearing every mapping, such as with AddInputMappingContexts and bClearPrevious.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "UDCore|Input")
+	void RefreshInputModes() { ApplyStack(); }
+
+	/** Returns a description of the stack and of the contexts it applies, for debug views and logs. */
+	UFUNCTION(BlueprintPure, Category = "UDCore|Input")
+	FString GetDebugString() const;
+
+	//~ Begin ULocalPlayerSubsystem Interface
+	virtual void PlayerControllerChanged(APlayerController* NewPlayerController) override;
+	//~ End ULocalPlayerSubsystem Interface
+
+private:
+
+	/** Applies the contexts of the stack, only changing the contexts that differ from the ones Enhanced Input has applied. */
+	void ApplyStack();
+
+	/** The modes, from the bottom to the top. */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UUDCoreInputModeData>> Stack;
+
+	/** The contexts and priorities the stack applied last, so it only removes its own contexts. */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<const UInputMappingContext>> AppliedContexts;
+	TArray<int32> AppliedPriorities;
+
+	/** Scratch storage reused by every ApplyStack call, swapped with the applied contexts once they have been applied. */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<const UInputMappingContext>> DesiredContexts;
+	TArray<int32> DesiredPriorities;
+};
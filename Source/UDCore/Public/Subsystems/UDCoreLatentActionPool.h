@@ -0,0 +1,89 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "UObject/Interface.h"
+#include "UDCoreLatentActionPool.generated.h"
+
+UINTERFACE(MinimalAPI, meta=(CannotImplementInterfaceInBlueprint))
+class UUDCorePoolableLatentAction : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Implemented by latent actions that can be reused through the UUDCoreLatentActionPool.
+ */
+class UDCORE_API IUDCorePoolableLatentAction
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Restores the action to its freshly constructed state, unbinding every delegate. Called when the action returns to the pool. */
+	virtual void ResetForPool() = 0;
+};
+
+/**
+ * The free latent actions of one class.
+ */
+USTRUCT()
+struct FUDLatentActionPoolList
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<UBlueprintAsyncActionBase>> Actions;
+};
+
+/**
+ * UDCoreLatentActionPool
+ *
+ * Keeps completed latent actions alive so they can be reused instead of being garbage collected.
+ * Pooling is disabled by default and enabled with the UDCore.LatentActionPool.Enable console variable.
+ * A pooled action must not be used after it has completed, as it may already run for another caller.
+ */
+UCLASS()
+class UDCORE_API UUDCoreLatentActionPool : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Returns a latent action of the provided class, reused from the pool of the world's game instance when possible.
+	 * @param WorldContextObject The world context object.
+	 */
+	template <typename TAction>
+	static TAction* NewAction(const UObject* WorldContextObject)
+	{
+		static_assert(TIsDerivedFrom<TAction, IUDCorePoolableLatentAction>::Value, "Pooled latent actions must implement IUDCorePoolableLatentAction.");
+		return CastChecked<TAction>(NewAction(WorldContextObject, TAction::StaticClass()));
+	}
+
+	/**
+	 * Returns a completed latent action to the pool it was taken from.
+	 * Must be called after SetReadyToDestroy. Does nothing for actions that were not created by a pool.
+	 * @param Action The completed action.
+	 */
+	static void ReleaseAction(UBlueprintAsyncActionBase* Action);
+
+	/** Returns true if latent actions are pooled. */
+	static bool IsPoolingEnabled();
+
+	/** Returns the number of free actions in the pool. */
+	int32 GetNumFreeActions() const;
+
+	virtual void Deinitialize() override;
+
+private:
+
+	static UBlueprintAsyncActionBase* NewAction(const UObject* WorldContextObject, UClass* ActionClass);
+
+	/** The free actions, by class. */
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FUDLatentActionPoolList> FreeActions;
+};
@@ -0,0 +1,99 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "UDCoreStringTypes.generated.h"
+
+/**
+ * The classes a character can belong to, as used by UUDCoreStringFunctionLibrary::GetCharacterProfile.
+ * A character is in at most one of Letter, Digit, Whitespace, Punctuation and Control, and may also be NonAscii.
+ * Some non-ASCII characters, such as most symbols, are in none of the other classes and are only NonAscii.
+ */
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EUDCoreCharacterClass : uint8
+{
+	None = 0 UMETA(Hidden),
+	Letter = 1 << 0,
+	Digit = 1 << 1,
+	Whitespace = 1 << 2,
+	Punctuation = 1 << 3,
+	Control = 1 << 4,
+	NonAscii = 1 << 5 UMETA(DisplayName = "Non-ASCII"),
+};
+ENUM_CLASS_FLAGS(EUDCoreCharacterClass)
+
+// The character classes of a string and how many characters of each class it holds.
+USTRUCT(BlueprintType)
+struct FUDCoreCharacterProfile
+{
+	GENERATED_BODY()
+
+	/** The classes of the characters in the string. */
+	UPROPERTY(BlueprintReadOnly, Category = "String", meta = (Bitmask, BitmaskEnum = "/Script/UDCore.EUDCoreCharacterClass"))
+	int32 Classes = 0;
+
+	/** The number of characters in the string. */
+	UPROPERTY(BlueprintReadOnly, Category = "String")
+	int32 NumCharacters = 0;
+
+	/** The number of letters in the string. */
+	UPROPERTY(BlueprintReadOnly, Category = "String")
+	int32 NumLetters = 0;
+
+	/** The number of digits in the string. */
+	UPROPERTY(BlueprintReadOnly, Category = "String")
+	int32 NumDigits = 0;
+
+	/** The number of whitespace characters in the string. */
+	UPROPERTY(BlueprintReadOnly, Category = "String")
+	int32 NumWhitespace = 0;
+
+	/** The number of punctuation characters in the string. */
+	UPROPERTY(BlueprintReadOnly, Category = "String")
+	int32 NumPunctuation = 0;
+
+	/** The number of control characters in the string. */
+	UPROPERTY(BlueprintReadOnly, Category = "String")
+	int32 NumControl = 0;
+
+	/** The number of non-ASCII characters in the string. */
+	UPROPERTY(BlueprintReadOnly, Category = "String")
+	int32 NumNonAscii = 0;
+
+	/** The number of characters in the string that are in none of Letter, Digit, Whitespace, Punctuation and Control. These are all non-ASCII. */
+	UPROPERTY(BlueprintReadOnly, Category = "String")
+	int32 NumUnclassified = 0;
+
+	/** Returns true if the string holds a character of any of the classes. */
+	bool HasAny(const EUDCoreCharacterClass InClasses) const
+	{
+		return (Classes & static_cast<int32>(InClasses)) != 0;
+	}
+
+	/**
+	 * Returns true if every character of the string is in one of the classes.
+	 * NonAscii does not restrict the other classes, so a non-ASCII letter passes with Letter alone.
+	 * It instead allows the characters that are in no other class, which otherwise fail.
+	 */
+	bool HasOnly(const EUDCoreCharacterClass InClasses) const
+	{
+		const int32 NonAscii = static_cast<int32>(EUDCoreCharacterClass::NonAscii);
+		if ((Classes & ~NonAscii & ~static_cast<int32>(InClasses)) != 0) { return false; }
+		return NumUnclassified == 0 || EnumHasAnyFlags(InClasses, EUDCoreCharacterClass::NonAscii);
+	}
+};
+
+/**
+ * Provides the orderings the string array sort functions can use.
+ */
+UENUM(BlueprintType)
+enum class EUDCoreStringSortMode : uint8
+{
+	/** The default FString ordering, ignoring the case of ASCII letters. */
+	CaseInsensitive,
+	/** Orders by character code, upper case letters before lower case letters. */
+	CaseSensitive,
+	/** Orders runs of digits by their numeric value, so "Item2" comes before "Item10". Ignores case. */
+	Natural,
+	/** Orders with the collation rules of the current culture. The slowest mode. */
+	Locale,
+};
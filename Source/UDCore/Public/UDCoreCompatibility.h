@@ -0,0 +1,19 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+namespace UDCore
+{
+	/**
+	 * The argument that keeps TArray from shrinking its allocation when removing elements.
+	 * UE 5.4 deprecates the bool overloads of RemoveAt, Pop, SetNum and the like in favour of EAllowShrinking.
+	 */
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4)
+	inline constexpr EAllowShrinking NoShrink = EAllowShrinking::No;
+#else
+	inline constexpr bool NoShrink = false;
+#endif
+}
@@ -0,0 +1,7 @@
+﻿// © 2024 Unreal Directive. All rights reserved.
+
+#pragma once
+
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("UDCore"), STATGROUP_UDCore, STATCAT_Advanced);
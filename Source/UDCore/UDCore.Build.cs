@@ -25,7 +25,9 @@ public class UDCore : ModuleRules
 				"Slate",
 				"SlateCore",
 				"AIModule",
+				"NavigationSystem",
 				"EnhancedInput",
+				"InputCore",
 				"ApplicationCore"
 			}
 		);
@@ -36,5 +38,7 @@ public class UDCore : ModuleRules
 			{
 			}
 		);
+
+		SetupGameplayDebuggerSupport(Target);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,190 @@
+﻿// Copyright Unreal Directive. All Rights Reserved.
+
+#include "Search/UDCoreActorLabelIndex.h"
+
+#include "GameFramework/Actor.h"
+#include "Internationalization/Regex.h"
+#include "UDCoreCompatibility.h"
+
+namespace
+{
+	/** The number of characters in a trigram. */
+	constexpr int32 TrigramLength = 3;
+
+	/** Packs three characters into a single trigram key. */
+	uint64 MakeTrigramKey(const TCHAR A, const TCHAR B, const TCHAR C)
+	{
+		return (static_cast<uint64>(A) << 42) | (static_cast<uint64>(B) << 21) | static_cast<uint64>(C);
+	}
+}
+
+void FUDCoreActorLabelIndex::Reset()
+{
+	Entries.Reset();
+	FreeEntries.Reset();
+	EntryIndices.Reset();
+	Trigrams.Reset();
+}
+
+void FUDCoreActorLabelIndex::AddActor(AActor* Actor)
+{
+	if (!IsValid(Actor)) { return; }
+
+	// Renamed actors are re-indexed under their new label.
+	if (const int32* ExistingIndex = EntryIndices.Find(Actor))
+	{
+		RemoveEntry(*ExistingIndex);
+	}
+
+	const int32 EntryIndex = FreeEntries.IsEmpty() ? Entries.AddDefaulted() : FreeEntries.Pop(UDCore::NoShrink);
+	FEntry& Entry = Entries[EntryIndex];
+	Entry.Actor = Actor;
+	Entry.Label = Actor->GetActorLabel().ToLower();
+	EntryIndices.Add(Actor, EntryIndex);
+
+	TArray<uint64, TInlineAllocator<64>> LabelTrigrams;
+	GetTrigrams(Entry.Label, LabelTrigrams);
+	for (const uint64 Trigram : LabelTrigrams)
+	{
+		Trigrams.FindOrAdd(Trigram).Add(EntryIndex);
+	}
+}
+
+void FUDCoreActorLabelIndex::RemoveActor(const AActor* Actor)
+{
+	int32 EntryIndex = INDEX_NONE;
+	if (EntryIndices.RemoveAndCopyValue(Actor, EntryIndex))
+	{
+		RemoveEntry(EntryIndex);
+	}
+}
+
+void FUDCoreActorLabelIndex::RemoveEntry(const int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+
+	TArray<uint64, TInlineAllocator<64>> LabelTrigrams;
+	GetTrigrams(Entry.Label, LabelTrigrams);
+	for (const uint64 Trigram : LabelTrigrams)
+	{
+		if (TArray<int32>* Postings = Trigrams.Find(Trigram))
+		{
+			Postings->RemoveSingleSwap(EntryIndex, UDCore::NoShrink);
+			if (Postings->IsEmpty())
+			{
+				Trigrams.Remove(Trigram);
+			}
+		}
+	}
+
+	Entry.Actor.Reset();
+	Entry.Label.Reset();
+	FreeEntries.Add(EntryIndex);
+}
+
+void FUDCoreActorLabelIndex::GetTrigrams(const FStringView Text, TArray<uint64, TInlineAllocator<64>>& OutTrigrams)
+{
+	for (int32 Index = 0; Index + TrigramLength <= Text.Len(); ++Index)
+	{
+		OutTrigrams.AddUnique(MakeTrigramKey(Text[Index], Text[Index + 1], Text[Index + 2]));
+	}
+}
+
+bool FUDCoreActorLabelIndex::GatherCandidates(const FStringView Literal, TArray<int32>& OutCandidates) const
+{
+	if (Literal.Len() < TrigramLength) { return false; }
+
+	// Every label containing the literal contains all of its trigrams, so the rarest trigram is the smallest superset.
+	const TArray<int32>* SmallestPostings = nullptr;
+	for (int32 Index = 0; Index + TrigramLength <= Literal.Len(); ++Index)
+	{
+		const TArray<int32>* Postings = Trigrams.Find(MakeTrigramKey(Literal[Index], Literal[Index + 1], Literal[Index + 2]));
+		if (!Postings)
+		{
+			// No label contains this trigram, so nothing can match.
+			OutCandidates.Reset();
+			return true;
+		}
+
+		if (!SmallestPostings || Postings->Num() < SmallestPostings->Num())
+		{
+			SmallestPostings = Postings;
+		}
+	}
+
+	OutCandidates = *SmallestPostings;
+	return true;
+}
+
+void FUDCoreActorLabelIndex::Find(const FString& Query, const EUDLabelMatchMode MatchMode, TArray<AActor*>& OutActors) const
+{
+	const FString LowerQuery = Query.ToLower();
+
+	// Pick the literal used to narrow down the candidates.
+	FStringView Literal;
+	if (MatchMode == EUDLabelMatchMode::Prefix || MatchMode == EUDLabelMatchMode::Substring)
+	{
+		Literal = LowerQuery;
+	}
+	else if (MatchMode == EUDLabelMatchMode::Wildcard)
+	{
+		// Any label matching the pattern contains each of its literal runs, so the longest run is used.
+		int32 RunStart = 0;
+		for (int32 Index = 0; Index <= LowerQuery.Len(); ++Index)
+		{
+			if (Index == LowerQuery.Len() || LowerQuery[Index] == TEXT('*') || LowerQuery[Index] == TEXT('?'))
+			{
+				if (Index - RunStart > Literal.Len())
+				{
+					Literal = FStringView(*LowerQuery + RunStart, Index - RunStart);
+				}
+				RunStart = Index + 1;
+			}
+		}
+	}
+
+	TArray<int32> Candidates;
+	const bool bHasCandidates = GatherCandidates(Literal, Candidates);
+	if (!bHasCandidates)
+	{
+		Candidates.Reserve(Entries.Num());
+		for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+		{
+			Candidates.Add(EntryIndex);
+		}
+	}
+
+	const FRegexPattern RegexPattern(MatchMode == EUDLabelMatchMode::Regex ? Query : FString(), ERegexPatternFlags::CaseInsensitive);
+
+	for (const int32 EntryIndex : Candidates)
+	{
+		const FEntry& Entry = Entries[EntryIndex];
+		AActor* Actor = Entry.Actor.Get();
+		if (!Actor) { continue; }
+
+		bool bMatches = false;
+		switch (MatchMode)
+		{
+		case EUDLabelMatchMode::Prefix:
+			bMatches = Entry.Label.StartsWith(LowerQuery, ESearchCase::CaseSensitive);
+			break;
+		case EUDLabelMatchMode::Substring:
+			bMatches = Entry.Label.Contains(LowerQuery, ESearchCase::CaseSensitive);
+			break;
+		case EUDLabelMatchMode::Wildcard:
+			bMatches = Entry.Label.MatchesWildcard(LowerQuery, ESearchCase::CaseSensitive);
+			break;
+		case EUDLabelMatchMode::Regex:
+			{
+				FRegexMatcher RegexMatcher(RegexPattern, Entry.Label);
+				bMatches = RegexMatcher.FindNext();
+			}
+			break;
+		}
+
+		if (bMatches)
+		{
+			OutActors.Add(Actor);
+		}
+	}
+}
@@ -7,6 +7,371 @@
 #include "Materials/MaterialExpressionTextureObject.h"
 #include "EditorViewportClient.h"
 #include "Materials/MaterialExpressionTextureSample.h"
+#include "Engine/StaticMesh.h"
+#include "StaticMeshCompiler.h"
+#include "ScopedTransaction.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "PhysicsEngine/PhysicsAsset.h"
+#include "Engine/SkeletalMesh.h"
+#include "Rendering/SkeletalMeshRenderData.h"
+#include "Materials/MaterialExpressionTextureBase.h"
+#include "NiagaraComponent.h"
+#include "Editor.h"
+#include "Misc/CoreDelegates.h"
+#include "ActorEditorUtils.h"
+#include "GameFramework/WorldSettings.h"
+#include "WorldPartition/WorldPartition.h"
+
+#define LOCTEXT_NAMESPACE "UDCoreEditorActorSubsystem"
+
+namespace
+{
+	/**
+	 * Applies changes to and rebuilds the provided Static Meshes in chunks.
+	 * Each chunk is built in parallel and waited on before the next one starts, so that only a bounded number of
+	 * builds hold their intermediate data in memory at once.
+	 * @param StaticMeshes The Static Meshes to build.
+	 * @param MaxConcurrentBuilds The maximum number of builds in flight. 0 will use the number of available cores.
+	 * @param SlowTask The slow task used to report progress and to check for cancellation.
+	 * @param PreBuild Called on each Static Mesh of a chunk before the chunk is built.
+	 * @param PostBuild Called on each Static Mesh of a chunk once the chunk has been built.
+	 * @returns False if the build was cancelled before every Static Mesh was built.
+	 */
+	bool BatchBuildStaticMeshes(
+		const TArray<UStaticMesh*>& StaticMeshes,
+		const int32 MaxConcurrentBuilds,
+		FScopedSlowTask& SlowTask,
+		const TFunctionRef<void(UStaticMesh*)> PreBuild,
+		const TFunctionRef<void(UStaticMesh*)> PostBuild)
+	{
+		const int32 ChunkSize = MaxConcurrentBuilds > 0 ? MaxConcurrentBuilds : FMath::Max(1, FPlatformMisc::NumberOfCores());
+
+		for (int32 ChunkStart = 0; ChunkStart < StaticMeshes.Num(); ChunkStart += ChunkSize)
+		{
+			if (SlowTask.ShouldCancel()) { return false; }
+
+			const int32 ChunkCount = FMath::Min(ChunkSize, StaticMeshes.Num() - ChunkStart);
+			SlowTask.EnterProgressFrame(ChunkCount);
+
+			const TArray<UStaticMesh*> Chunk(StaticMeshes.GetData() + ChunkStart, ChunkCount);
+			for (UStaticMesh* StaticMesh : Chunk) { PreBuild(StaticMesh); }
+
+			UStaticMesh::BatchBuild(Chunk, true);
+			FStaticMeshCompilingManager::Get().FinishCompilation(Chunk);
+
+			for (UStaticMesh* StaticMesh : Chunk) { PostBuild(StaticMesh); }
+		}
+
+		return true;
+	}
+
+	/** Returns true if the LODs after LOD0 of the provided Static Mesh already match the provided presets. */
+	bool HasMatchingLODs(const UStaticMesh* StaticMesh, const TArray<FUDLODPreset>& LODs)
+	{
+		if (StaticMesh->GetNumSourceModels() != LODs.Num() + 1) { return false; }
+
+		for (int32 Index = 0; Index < LODs.Num(); ++Index)
+		{
+			// An LOD with its own mesh is built from it instead of being reduced, whatever its reduction settings are.
+			const FStaticMeshSourceModel& SourceModel = StaticMesh->GetSourceModel(Index + 1);
+			if (StaticMesh->IsMeshDescriptionValid(Index + 1) ||
+				!FMath::IsNearlyEqual(SourceModel.ReductionSettings.PercentTriangles, LODs[Index].PercentTriangles) ||
+				!FMath::IsNearlyEqual(SourceModel.ScreenSize.Default, LODs[Index].ScreenSize))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/** Returns true if an LOD after LOD0 of the provided Static Mesh has its own mesh, imported or authored by hand rather than reduced. */
+	bool HasCustomLODs(const UStaticMesh* StaticMesh)
+	{
+		for (int32 Index = 1; Index < StaticMesh->GetNumSourceModels(); ++Index)
+		{
+			if (StaticMesh->IsMeshDescriptionValid(Index)) { return true; }
+		}
+
+		return false;
+	}
+
+	/**
+	 * Returns the components of the provided actor that the mesh filters support.
+	 * Static Mesh, Skeletal Mesh and Niagara components are supported.
+	 */
+	void GetMeshComponents(const AActor* Actor, TArray<const UPrimitiveComponent*>& OutMeshComponents)
+	{
+		TArray<UPrimitiveComponent*> PrimitiveComponents;
+		Actor->GetComponents<UPrimitiveComponent>(PrimitiveComponents, true);
+
+		for (const UPrimitiveComponent* PrimitiveComponent : PrimitiveComponents)
+		{
+			if (PrimitiveComponent &&
+				(PrimitiveComponent->IsA<UStaticMeshComponent>() ||
+				PrimitiveComponent->IsA<USkeletalMeshComponent>() ||
+				PrimitiveComponent->IsA<UNiagaraComponent>()))
+			{
+				OutMeshComponents.Add(PrimitiveComponent);
+			}
+		}
+	}
+
+	/** Returns the LOD0 render data of the Skeletal Mesh used by the provided component, if any. */
+	const FSkeletalMeshLODRenderData* GetSkeletalMeshLOD0RenderData(const USkeletalMeshComponent* SkeletalMeshComponent)
+	{
+		const USkeletalMesh* SkeletalMesh = SkeletalMeshComponent->GetSkeletalMeshAsset();
+		if (!SkeletalMesh) { return nullptr; }
+
+		const FSkeletalMeshRenderData* RenderData = SkeletalMesh->GetResourceForRendering();
+		if (!RenderData || RenderData->LODRenderData.IsEmpty()) { return nullptr; }
+
+		return &RenderData->LODRenderData[0];
+	}
+
+	/** Returns the LOD0 vertex count of the mesh used by the provided component, or INDEX_NONE if it does not apply. */
+	int32 GetMeshVertexCount(const UPrimitiveComponent* MeshComponent)
+	{
+		if (const UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(MeshComponent))
+		{
+			const UStaticMesh* StaticMesh = StaticMeshComponent->GetStaticMesh();
+			return StaticMesh ? StaticMesh->GetNumVertices(0) : INDEX_NONE;
+		}
+
+		if (const USkeletalMeshComponent* SkeletalMeshComponent = Cast<USkeletalMeshComponent>(MeshComponent))
+		{
+			const FSkeletalMeshLODRenderData* LODRenderData = GetSkeletalMeshLOD0RenderData(SkeletalMeshComponent);
+			return LODRenderData ? static_cast<int32>(LODRenderData->GetNumVertices()) : INDEX_NONE;
+		}
+
+		// Niagara geometry is generated at runtime, so there is no fixed vertex count to compare against.
+		return INDEX_NONE;
+	}
+
+	/** Returns the LOD0 triangle count of the mesh used by the provided component, or INDEX_NONE if it does not apply. */
+	int32 GetMeshTriangleCount(const UPrimitiveComponent* MeshComponent)
+	{
+		if (const UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(MeshComponent))
+		{
+			const UStaticMesh* StaticMesh = StaticMeshComponent->GetStaticMesh();
+			return StaticMesh ? StaticMesh->GetNumTriangles(0) : INDEX_NONE;
+		}
+
+		if (const USkeletalMeshComponent* SkeletalMeshComponent = Cast<USkeletalMeshComponent>(MeshComponent))
+		{
+			const FSkeletalMeshLODRenderData* LODRenderData = GetSkeletalMeshLOD0RenderData(SkeletalMeshComponent);
+			if (!LODRenderData) { return INDEX_NONE; }
+
+			int32 TriangleCount = 0;
+			for (const FSkelMeshRenderSection& RenderSection : LODRenderData->RenderSections)
+			{
+				TriangleCount += RenderSection.NumTriangles;
+			}
+			return TriangleCount;
+		}
+
+		return INDEX_NONE;
+	}
+
+	/** Returns the LOD count of the mesh used by the provided component, or INDEX_NONE if it does not apply. */
+	int32 GetMeshLODCount(const UPrimitiveComponent* MeshComponent)
+	{
+		if (const UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(MeshComponent))
+		{
+			const UStaticMesh* StaticMesh = StaticMeshComponent->GetStaticMesh();
+			return StaticMesh ? StaticMesh->GetNumLODs() : INDEX_NONE;
+		}
+
+		if (const USkeletalMeshComponent* SkeletalMeshComponent = Cast<USkeletalMeshComponent>(MeshComponent))
+		{
+			const USkeletalMesh* SkeletalMesh = SkeletalMeshComponent->GetSkeletalMeshAsset();
+			return SkeletalMesh ? SkeletalMesh->GetLODNum() : INDEX_NONE;
+		}
+
+		return INDEX_NONE;
+	}
+
+	/**
+	 * Gets the local bounds of the mesh used by the provided component.
+	 * Niagara components use their fixed or last computed local bounds.
+	 * @returns False if the component has no mesh.
+	 */
+	bool GetMeshBounds(const UPrimitiveComponent* MeshComponent, FBoxSphereBounds& OutBounds)
+	{
+		if (const UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(MeshComponent))
+		{
+			const UStaticMesh* StaticMesh = StaticMeshComponent->GetStaticMesh();
+			if (!StaticMesh) { return false; }
+			OutBounds = StaticMesh->GetBounds();
+			return true;
+		}
+
+		if (const USkeletalMeshComponent* SkeletalMeshComponent = Cast<USkeletalMeshComponent>(MeshComponent))
+		{
+			const USkeletalMesh* SkeletalMesh = SkeletalMeshComponent->GetSkeletalMeshAsset();
+			if (!SkeletalMesh) { return false; }
+			OutBounds = SkeletalMesh->GetBounds();
+			return true;
+		}
+
+		if (const UNiagaraComponent* NiagaraComponent = Cast<UNiagaraComponent>(MeshComponent))
+		{
+			if (!NiagaraComponent->GetAsset()) { return false; }
+			OutBounds = NiagaraComponent->CalcBounds(FTransform::Identity);
+			return true;
+		}
+
+		return false;
+	}
+
+	/**
+	 * Gets the materials used by the provided component from the provided location.
+	 * Empty material slots are returned as null so that missing materials can be detected.
+	 * Niagara components only have the materials of their renderers, which are returned for every location.
+	 */
+	void GetMeshMaterials(const UPrimitiveComponent* MeshComponent, const EUDSearchLocation Location, TArray<UMaterialInterface*>& OutMaterials)
+	{
+		if (const UNiagaraComponent* NiagaraComponent = Cast<UNiagaraComponent>(MeshComponent))
+		{
+			NiagaraComponent->GetUsedMaterials(OutMaterials);
+			return;
+		}
+
+		if (Location == BaseAndOverride || Location == OverrideOnly)
+		{
+			for (int32 i = 0; i < MeshComponent->GetNumMaterials(); i++)
+			{
+				OutMaterials.Add(MeshComponent->GetMaterial(i));
+			}
+		}
+
+		if (Location == BaseAndOverride || Location == BaseOnly)
+		{
+			if (const UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(MeshComponent))
+			{
+				if (UStaticMesh* StaticMesh = StaticMeshComponent->GetStaticMesh())
+				{
+					for (int32 i = 0; i < StaticMesh->GetStaticMaterials().Num(); i++)
+					{
+						OutMaterials.Add(StaticMesh->GetMaterial(i));
+					}
+				}
+			}
+			else if (const USkeletalMeshComponent* SkeletalMeshComponent = Cast<USkeletalMeshComponent>(MeshComponent))
+			{
+				if (const USkeletalMesh* SkeletalMesh = SkeletalMeshComponent->GetSkeletalMeshAsset())
+				{
+					for (const FSkeletalMaterial& SkeletalMaterial : SkeletalMesh->GetMaterials())
+					{
+						OutMaterials.Add(SkeletalMaterial.MaterialInterface);
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * Gets the textures referenced by the Texture Sample and Texture Object expressions of the provided material.
+	 * Expressions without a texture are returned as null so that missing textures can be detected.
+	 */
+	void GetMaterialTextures(const UMaterialInterface* Material, TArray<UTexture*>& OutTextures)
+	{
+		const UMaterial* BaseMaterial = Material ? Material->GetMaterial() : nullptr;
+		if (!BaseMaterial) { return; }
+
+		for (const auto& Expression : BaseMaterial->GetExpressions())
+		{
+			// Texture Samples and Texture Objects both derive from the Texture Base expression.
+			if (const UMaterialExpressionTextureBase* TextureExpression = Cast<UMaterialExpressionTextureBase>(Expression))
+			{
+				OutTextures.Add(TextureExpression->Texture);
+			}
+		}
+	}
+
+	// Relative weights used to estimate the physics cost of an actor's collision.
+	// Movable bodies are updated in the broadphase every time they move, and overlap events add extra overlap queries.
+	constexpr float StaticBodyBroadphaseWeight = 1.0f;
+	constexpr float MovableBodyBroadphaseWeight = 4.0f;
+	constexpr float OverlapEventsBroadphaseMultiplier = 2.0f;
+	constexpr float PrimitiveShapeNarrowphaseWeight = 1.0f;
+	constexpr float ConvexHullNarrowphaseWeight = 2.0f;
+	constexpr float ConvexVertexNarrowphaseWeight = 0.05f;
+	constexpr float ComplexTriangleNarrowphaseWeight = 0.02f;
+
+	/** Returns the number of triangles used as collision by a component using complex as simple collision. */
+	int32 GetComplexCollisionTriangleCount(const UPrimitiveComponent* PrimitiveComponent)
+	{
+		const UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(PrimitiveComponent);
+		if (!StaticMeshComponent) { return 0; }
+
+		const UStaticMesh* StaticMesh = StaticMeshComponent->GetStaticMesh();
+		if (!StaticMesh || StaticMesh->GetNumLODs() == 0) { return 0; }
+
+		return StaticMesh->GetNumTriangles(FMath::Clamp(StaticMesh->LODForCollision, 0, StaticMesh->GetNumLODs() - 1));
+	}
+
+	/**
+	 * FilterActorsByName uses the actor label index when the filtered actors are at least this fraction of the indexed actors.
+	 * Below it, searching the whole index costs more than comparing the labels of the filtered actors.
+	 */
+	constexpr int32 LabelIndexMinFilteredFraction = 8;
+
+	/** Returns true if GetAllLevelActors lists the provided actor, so that the actor label index covers the same actors. */
+	bool IsListedLevelActor(const AActor* Actor)
+	{
+		return IsValid(Actor) &&
+			Actor->IsEditable() &&
+			Actor->IsListedInSceneOutliner() &&
+			!Actor->IsTemplate() &&
+			!Actor->HasAnyFlags(RF_Transient) &&
+			!FActorEditorUtils::IsABuilderBrush(Actor) &&
+			!Actor->IsA<AWorldSettings>();
+	}
+}
+
+void UUDCoreEditorActorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Keep the actor label index up to date instead of rebuilding it for every search.
+	ActorLabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddUObject(this, &UUDCoreEditorActorSubsystem::OnActorLabelChanged);
+	LevelAddedToWorldHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UUDCoreEditorActorSubsystem::OnLevelsChanged);
+	LevelRemovedFromWorldHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UUDCoreEditorActorSubsystem::OnLevelsChanged);
+	MapChangeHandle = FEditorDelegates::MapChange.AddUObject(this, &UUDCoreEditorActorSubsystem::OnMapChanged);
+	PostUndoRedoHandle = FEditorDelegates::PostUndoRedo.AddUObject(this, &UUDCoreEditorActorSubsystem::OnActorListChanged);
+
+	if (GEngine)
+	{
+		LevelActorAddedHandle = GEngine->OnLevelActorAdded().AddUObject(this, &UUDCoreEditorActorSubsystem::OnLevelActorAdded);
+		LevelActorDeletedHandle = GEngine->OnLevelActorDeleted().AddUObject(this, &UUDCoreEditorActorSubsystem::OnLevelActorDeleted);
+		LevelActorListChangedHandle = GEngine->OnLevelActorListChanged().AddUObject(this, &UUDCoreEditorActorSubsystem::OnActorListChanged);
+	}
+}
+
+void UUDCoreEditorActorSubsystem::Deinitialize()
+{
+	FCoreDelegates::OnActorLabelChanged.Remove(ActorLabelChangedHandle);
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedToWorldHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedFromWorldHandle);
+	FEditorDelegates::MapChange.Remove(MapChangeHandle);
+	FEditorDelegates::PostUndoRedo.Remove(PostUndoRedoHandle);
+
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(LevelActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(LevelActorDeletedHandle);
+		GEngine->OnLevelActorListChanged().Remove(LevelActorListChangedHandle);
+	}
+
+	BindWorldPartitionEvents(nullptr);
+	ActorLabelIndex.Reset();
+
+	Super::Deinitialize();
+}
 
 void UUDCoreEditorActorSubsystem::FocusActorsInViewport(const TArray<AActor*> Actors, const bool bInstant)
 {
@@ -40,6 +405,88 @@ TArray<UClass*> UUDCoreEditorActorSubsystem::GetAllLevelClasses()
 	return ActorClasses;
 }
 
+void UUDCoreEditorActorSubsystem::RebuildActorLabelIndex()
+{
+	ActorLabelIndex.Reset();
+	ActorLabelIndexWorld = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	BindWorldPartitionEvents(ActorLabelIndexWorld.Get());
+
+	for (AActor* Actor : GetAllLevelActors())
+	{
+		ActorLabelIndex.AddActor(Actor);
+	}
+
+	bActorLabelIndexDirty = false;
+	UE_LOG(LogUDCoreEditor, Verbose, TEXT("Rebuilt the actor label index with %i actors."), ActorLabelIndex.Num());
+}
+
+const FUDCoreActorLabelIndex& UUDCoreEditorActorSubsystem::GetActorLabelIndex()
+{
+	if (bActorLabelIndexDirty || !ActorLabelIndexWorld.IsValid())
+	{
+		RebuildActorLabelIndex();
+	}
+	return ActorLabelIndex;
+}
+
+bool UUDCoreEditorActorSubsystem::IsActorInLabelIndexWorld(const AActor* Actor) const
+{
+	return !bActorLabelIndexDirty && Actor && ActorLabelIndexWorld.IsValid() && Actor->GetWorld() == ActorLabelIndexWorld.Get();
+}
+
+void UUDCoreEditorActorSubsystem::BindWorldPartitionEvents(UWorld* World)
+{
+	UWorldPartition* WorldPartition = World ? World->GetWorldPartition() : nullptr;
+	if (WorldPartition == BoundWorldPartition.Get()) { return; }
+
+	if (UWorldPartition* PreviousWorldPartition = BoundWorldPartition.Get())
+	{
+		PreviousWorldPartition->LoaderAdapterStateChanged.Remove(LoaderAdapterStateChangedHandle);
+	}
+	LoaderAdapterStateChangedHandle.Reset();
+	BoundWorldPartition = WorldPartition;
+
+	// Loading or unloading a region of a World Partition world adds and removes actors in batches.
+	if (WorldPartition)
+	{
+		LoaderAdapterStateChangedHandle = WorldPartition->LoaderAdapterStateChanged.AddWeakLambda(this, [this](const IWorldPartitionActorLoaderInterface::ILoaderAdapter*)
+		{
+			OnActorListChanged();
+		});
+	}
+}
+
+void UUDCoreEditorActorSubsystem::OnActorLabelChanged(AActor* Actor)
+{
+	if (IsActorInLabelIndexWorld(Actor) && IsListedLevelActor(Actor)) { ActorLabelIndex.AddActor(Actor); }
+}
+
+void UUDCoreEditorActorSubsystem::OnLevelActorAdded(AActor* Actor)
+{
+	if (IsActorInLabelIndexWorld(Actor) && IsListedLevelActor(Actor)) { ActorLabelIndex.AddActor(Actor); }
+}
+
+void UUDCoreEditorActorSubsystem::OnLevelActorDeleted(AActor* Actor)
+{
+	ActorLabelIndex.RemoveActor(Actor);
+}
+
+void UUDCoreEditorActorSubsystem::OnLevelsChanged(ULevel* Level, UWorld* World)
+{
+	if (World && World == ActorLabelIndexWorld.Get()) { bActorLabelIndexDirty = true; }
+}
+
+void UUDCoreEditorActorSubsystem::OnMapChanged(uint32 MapChangeFlags)
+{
+	bActorLabelIndexDirty = true;
+}
+
+void UUDCoreEditorActorSubsystem::OnActorListChanged()
+{
+	// Undo, redo and World Partition loads add and remove actors without notifying each of them, so the index is rebuilt on its next use.
+	bActorLabelIndexDirty = true;
+}
+
 void UUDCoreEditorActorSubsystem::FilterStaticMeshActors(
 	TArray<AStaticMeshActor*>& OutStaticMeshActors,
 	TArray<AActor*> ActorsToFilter) const
@@ -65,14 +512,36 @@ void UUDCoreEditorActorSubsystem::FilterActorsByName(
 	const FString& ActorName,
 	const EUDInclusivity Inclusivity)
 {
+	// Match the actors of the indexed world through the label index, and only compare the labels of the other actors.
+	// The index is never rebuilt here, so filtering a few actors does not cost a pass over the whole world.
+	const UUDCoreEditorActorSubsystem* ActorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UUDCoreEditorActorSubsystem>() : nullptr;
+	const AActor* const* FirstActor = Actors.FindByPredicate([](const AActor* Actor) { return Actor != nullptr; });
+	const bool bUseLabelIndex = ActorSubsystem && FirstActor &&
+		ActorSubsystem->IsActorInLabelIndexWorld(*FirstActor) &&
+		Actors.Num() * LabelIndexMinFilteredFraction >= ActorSubsystem->ActorLabelIndex.Num();
+
+	const FUDCoreActorLabelIndex* LabelIndex = nullptr;
+	TSet<AActor*> IndexedMatches;
+	if (bUseLabelIndex)
+	{
+		LabelIndex = &ActorSubsystem->ActorLabelIndex;
+
+		TArray<AActor*> MatchingActors;
+		LabelIndex->Find(ActorName, EUDLabelMatchMode::Substring, MatchingActors);
+		IndexedMatches.Append(MatchingActors);
+	}
+
+	TSet<AActor*> AddedActors(FilteredActors);
 	for (AActor* Actor : Actors)
 	{
-		if (!Actor || FilteredActors.Contains(Actor)) { continue; }
+		if (!Actor) { continue; }
 
-		if (Actor->GetActorLabel().Contains(ActorName) == (Inclusivity == Include))
-		{
-			FilteredActors.AddUnique(Actor);
-		}
+		const bool bMatches = LabelIndex && LabelIndex->Contains(Actor) ? IndexedMatches.Contains(Actor) : Actor->GetActorLabel().Contains(ActorName);
+		if (bMatches != (Inclusivity == Include)) { continue; }
+
+		bool bAlreadyAdded = false;
+		AddedActors.Add(Actor, &bAlreadyAdded);
+		if (!bAlreadyAdded) { FilteredActors.Add(Actor); }
 	}
 
 	UE_LOG(
@@ -147,49 +616,24 @@ void UUDCoreEditorActorSubsystem::FilterActorsByMaterialName(
 	{
 		if (!Actor || FilteredActors.Contains(Actor)) { continue; }
 
-		// Check for Static Mesh Components
-		TArray<UStaticMeshComponent*> StaticMeshComponents;
-		Actor->GetComponents<UStaticMeshComponent>(StaticMeshComponents, true);
+		TArray<const UPrimitiveComponent*> MeshComponents;
+		GetMeshComponents(Actor, MeshComponents);
 
-		for (const UStaticMeshComponent* StaticMeshComponent : StaticMeshComponents)
+		for (const UPrimitiveComponent* MeshComponent : MeshComponents)
 		{
-			if (!StaticMeshComponent)
-			{
-				continue;
-			}
+			TArray<UMaterialInterface*> Materials;
+			GetMeshMaterials(MeshComponent, MaterialSource, Materials);
 
-			if (MaterialSource == BaseAndOverride || MaterialSource == OverrideOnly)
+			for (const UMaterialInterface* Material : Materials)
 			{
-				for (int32 i = 0; i < StaticMeshComponent->GetNumMaterials(); i++)
+				if (!Material)
 				{
-					if (StaticMeshComponent->GetMaterial(i) == nullptr)
-					{
-						continue;
-					}
-					if (StaticMeshComponent->GetMaterial(i)->GetName().Contains(MaterialName) == (Inclusivity ==
-						Include))
-					{
-						FilteredActors.AddUnique(Actor);
-						break;
-					}
+					continue;
 				}
-			}
-
-			if (MaterialSource == BaseAndOverride || MaterialSource == BaseOnly)
-			{
-				if (!StaticMeshComponent->GetStaticMesh()) { return; }
-				for (int32 i = 0; i < StaticMeshComponent->GetStaticMesh()->GetStaticMaterials().Num(); i++)
+				if (Material->GetName().Contains(MaterialName) == (Inclusivity == Include))
 				{
-					if (StaticMeshComponent->GetStaticMesh()->GetMaterial(i) == nullptr)
-					{
-						continue;
-					}
-					if (StaticMeshComponent->GetStaticMesh()->GetMaterial(i)->GetName().Contains(MaterialName) == (
-						Inclusivity == Include))
-					{
-						FilteredActors.AddUnique(Actor);
-						break;
-					}
+					FilteredActors.AddUnique(Actor);
+					break;
 				}
 			}
 		}
@@ -206,48 +650,26 @@ void UUDCoreEditorActorSubsystem::FilterActorsByMaterial(
 	const EUDSearchLocation MaterialSource,
 	const EUDInclusivity Inclusivity)
 {
+	const UMaterialInterface* MaterialToFind = Material.LoadSynchronous();
+
 	for (AActor* Actor : Actors)
 	{
 		if (!Actor || FilteredActors.Contains(Actor)) { continue; }
 
-		// Check for Static Mesh Components
-		TArray<UStaticMeshComponent*> StaticMeshComponents;
-		Actor->GetComponents<UStaticMeshComponent>(StaticMeshComponents, true);
+		TArray<const UPrimitiveComponent*> MeshComponents;
+		GetMeshComponents(Actor, MeshComponents);
 
-		for (const UStaticMeshComponent* StaticMeshComponent : StaticMeshComponents)
+		for (const UPrimitiveComponent* MeshComponent : MeshComponents)
 		{
-			if (!StaticMeshComponent)
-			{
-				continue;
-			}
+			TArray<UMaterialInterface*> Materials;
+			GetMeshMaterials(MeshComponent, MaterialSource, Materials);
 
-			if (MaterialSource == BaseAndOverride || MaterialSource == OverrideOnly)
+			for (const UMaterialInterface* MeshMaterial : Materials)
 			{
-				for (int32 i = 0; i < StaticMeshComponent->GetNumMaterials(); i++)
+				if (MeshMaterial == MaterialToFind == (Inclusivity == Include))
 				{
-					if (StaticMeshComponent->GetMaterial(i) == Material.LoadSynchronous() == (Inclusivity == Include))
-					{
-						FilteredActors.AddUnique(Actor);
-						break;
-					}
-				}
-			}
-
-			if (MaterialSource == BaseAndOverride || MaterialSource == BaseOnly)
-			{
-				if (!StaticMeshComponent->GetStaticMesh())
-				{
-					continue;
-				}
-
-				for (int32 i = 0; i < StaticMeshComponent->GetStaticMesh()->GetStaticMaterials().Num(); i++)
-				{
-					if (StaticMeshComponent->GetStaticMesh()->GetMaterial(i) == Material.LoadSynchronous() == (
-						Inclusivity == Include))
-					{
-						FilteredActors.AddUnique(Actor);
-						break;
-					}
+					FilteredActors.AddUnique(Actor);
+					break;
 				}
 			}
 		}
@@ -361,31 +783,18 @@ void UUDCoreEditorActorSubsystem::FilterActorsByVertCount(
 	{
 		if (!Actor || FilteredActors.Contains(Actor)) { continue; }
 
-		for (const auto Component : Actor->GetComponents())
-		{
-			if (!Component)
-			{
-				continue;
-			}
-			if (!Component->IsA(UStaticMeshComponent::StaticClass()))
-			{
-				continue;
-			}
-
-			const UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(Component);
+		TArray<const UPrimitiveComponent*> MeshComponents;
+		GetMeshComponents(Actor, MeshComponents);
 
-			if (!StaticMeshComponent)
-			{
-				continue;
-			}
-			if (!StaticMeshComponent->GetStaticMesh())
+		for (const UPrimitiveComponent* MeshComponent : MeshComponents)
+		{
+			const int32 VertCount = GetMeshVertexCount(MeshComponent);
+			if (VertCount == INDEX_NONE)
 			{
 				continue;
 			}
 
-			const int32 VertCount = StaticMeshComponent->GetStaticMesh()->GetNumVertices(0);
-
-			if (VertCount >= MinVertCount && VertCount <= MaxVertCount == (Inclusivity == Include))
+			if ((VertCount >= MinVertCount && VertCount <= MaxVertCount) == (Inclusivity == Include))
 			{
 				FilteredActors.AddUnique(Actor);
 			}
@@ -408,31 +817,18 @@ void UUDCoreEditorActorSubsystem::FilterActorsByTriCount(
 	{
 		if (!Actor || FilteredActors.Contains(Actor)) { continue; }
 
-		for (const auto Component : Actor->GetComponents())
-		{
-			if (!Component)
-			{
-				continue;
-			}
-			if (!Component->IsA(UStaticMeshComponent::StaticClass()))
-			{
-				continue;
-			}
-
-			const UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(Component);
+		TArray<const UPrimitiveComponent*> MeshComponents;
+		GetMeshComponents(Actor, MeshComponents);
 
-			if (!StaticMeshComponent)
-			{
-				continue;
-			}
-			if (!StaticMeshComponent->GetStaticMesh())
+		for (const UPrimitiveComponent* MeshComponent : MeshComponents)
+		{
+			const int32 TriCount = GetMeshTriangleCount(MeshComponent);
+			if (TriCount == INDEX_NONE)
 			{
 				continue;
 			}
 
-			const int32 TriCount = StaticMeshComponent->GetStaticMesh()->GetNumTriangles(0);
-
-			if (TriCount >= MinTriCount && TriCount <= MaxTriCount == (Inclusivity == Include))
+			if ((TriCount >= MinTriCount && TriCount <= MaxTriCount) == (Inclusivity == Include))
 			{
 				FilteredActors.AddUnique(Actor);
 			}
@@ -527,6 +923,46 @@ void UUDCoreEditorActorSubsystem::FilterActorsByStaticMeshBounds(
 	       MaxBounds.X, MaxBounds.Y, MaxBounds.Z);
 }
 
+void UUDCoreEditorActorSubsystem::FilterActorsByMeshBounds(
+	const TArray<AActor*>& Actors,
+	TArray<AActor*>& FilteredActors,
+	const FVector& MinBounds,
+	const FVector& MaxBounds,
+	const EUDInclusivity Inclusivity)
+{
+	for (AActor* Actor : Actors)
+	{
+		if (!Actor || FilteredActors.Contains(Actor)) { continue; }
+
+		TArray<const UPrimitiveComponent*> MeshComponents;
+		GetMeshComponents(Actor, MeshComponents);
+
+		for (const UPrimitiveComponent* MeshComponent : MeshComponents)
+		{
+			FBoxSphereBounds MeshBounds;
+			if (!GetMeshBounds(MeshComponent, MeshBounds))
+			{
+				continue;
+			}
+
+			const FVector MeshSize = MeshBounds.BoxExtent * 2;
+
+			if ((MinBounds.X <= MeshSize.X && MeshSize.X <= MaxBounds.X &&
+				MinBounds.Y <= MeshSize.Y && MeshSize.Y <= MaxBounds.Y &&
+				MinBounds.Z <= MeshSize.Z && MeshSize.Z <= MaxBounds.Z) == (Inclusivity == Include))
+			{
+				FilteredActors.AddUnique(Actor);
+			}
+		}
+	}
+
+	UE_LOG(LogUDCoreEditor, Display,
+	       TEXT("Actor Filter: Found %i actors that %s within the mesh bounds (%f, %f, %f) and (%f, %f, %f)"),
+	       FilteredActors.Num(), Inclusivity == EUDInclusivity::Include ? TEXT("is") : TEXT("is not"), MinBounds.X,
+	       MinBounds.Y, MinBounds.Z,
+	       MaxBounds.X, MaxBounds.Y, MaxBounds.Z);
+}
+
 void UUDCoreEditorActorSubsystem::FilterActorsByWorldLocation(
 	const TArray<AActor*>& Actors,
 	TArray<AActor*>& FilteredActors,
@@ -563,24 +999,18 @@ void UUDCoreEditorActorSubsystem::FilterActorsByLODCount(
 	{
 		if (!Actor || FilteredActors.Contains(Actor)) { continue; }
 
-		TArray<UStaticMeshComponent*> StaticMeshComponents;
-		Actor->GetComponents<UStaticMeshComponent>(StaticMeshComponents, true);
+		TArray<const UPrimitiveComponent*> MeshComponents;
+		GetMeshComponents(Actor, MeshComponents);
 
-		for (const UStaticMeshComponent* StaticMeshComponent : StaticMeshComponents)
+		for (const UPrimitiveComponent* MeshComponent : MeshComponents)
 		{
-			if (!StaticMeshComponent)
+			const int32 LODCount = GetMeshLODCount(MeshComponent);
+			if (LODCount == INDEX_NONE)
 			{
 				continue;
 			}
 
-			const UStaticMesh* StaticMesh = StaticMeshComponent->GetStaticMesh();
-			if (!StaticMesh)
-			{
-				continue;
-			}
-
-			if ((StaticMesh->GetNumLODs() >= MinLODs && StaticMesh->GetNumLODs() <= MaxLODs) == (Inclusivity ==
-				Include))
+			if ((LODCount >= MinLODs && LODCount <= MaxLODs) == (Inclusivity == Include))
 			{
 				FilteredActors.AddUnique(Actor);
 			}
@@ -588,8 +1018,8 @@ void UUDCoreEditorActorSubsystem::FilterActorsByLODCount(
 	}
 
 	UE_LOG(LogUDCoreEditor, Display, TEXT("Actor Filter: Found %i actors that %s between %i and %i LODs"),
-	       FilteredActors.Num(), Inclusivity == EUDInclusivity::Include ? TEXT("has") : TEXT("does not have"), MinLODs,
-	       MaxLODs);
+	       FilteredActors.Num(), Inclusivity == EUDInclusivity::Include ? TEXT("has") : TEXT("does not have"),
+	       MinLODs, MaxLODs);
 }
 
 void UUDCoreEditorActorSubsystem::FilterActorsByNaniteState(
@@ -861,105 +1291,37 @@ void UUDCoreEditorActorSubsystem::FilterActorsByTextureName(
 	{
 		if (!Actor || FilteredActors.Contains(Actor)) { continue; }
 
-		TArray<UStaticMeshComponent*> StaticMeshComponents;
-		Actor->GetComponents<UStaticMeshComponent>(StaticMeshComponents, true);
+		TArray<const UPrimitiveComponent*> MeshComponents;
+		GetMeshComponents(Actor, MeshComponents);
 
-		for (const UStaticMeshComponent* StaticMeshComponent : StaticMeshComponents)
+		for (const UPrimitiveComponent* MeshComponent : MeshComponents)
 		{
-			if (!StaticMeshComponent)
-			{
-				continue;
-			}
+			TArray<UMaterialInterface*> Materials;
+			GetMeshMaterials(MeshComponent, Source, Materials);
 
-			if (Source == BaseAndOverride || Source == OverrideOnly)
+			for (const UMaterialInterface* Material : Materials)
 			{
-				for (UMaterialInterface* Material : StaticMeshComponent->GetMaterials())
+				if (!Material)
 				{
-					if (!Material)
-					{
-						continue;
-					}
-
-					for (const auto& Expression : Material->GetMaterial()->GetExpressions())
-					{
-						if (!Expression)
-						{
-							continue;
-						}
-
-						// Check if the Material Expression is a Texture Sample Expression.
-						if (Expression->IsA(UMaterialExpressionTextureSample::StaticClass()))
-						{
-							const UMaterialExpressionTextureSample* TextureSample = Cast<
-								UMaterialExpressionTextureSample>(Expression);
-							if (TextureSample->Texture.GetName().Contains(TextureName) == (Inclusivity ==
-								Include))
-							{
-								FilteredActors.AddUnique(Actor);
-								break;
-							}
-						}
-
-						// Check if the Material Expression is a Texture Object instead of a Texture Sample.
-						if (Expression->IsA(UMaterialExpressionTextureObject::StaticClass()))
-						{
-							const UMaterialExpressionTextureObject* TextureObject = Cast<UMaterialExpressionTextureObject>(Expression);
-							if (TextureObject->Texture.GetName().Contains(TextureName) == (Inclusivity ==
-								Include))
-							{
-								FilteredActors.AddUnique(Actor);
-								break;
-							}
-						}
-					}
+					continue;
 				}
-			}
 
-			if (Source == BaseAndOverride || Source == BaseOnly)
-			{
-				for (int32 i = 0; i < StaticMeshComponent->GetStaticMesh()->GetStaticMaterials().Num(); i++)
-				{
-					UMaterialInterface* Material = StaticMeshComponent->GetStaticMesh()->GetMaterial(i);
-					if (!Material)
-					{
-						continue;
-					}
+				TArray<UTexture*> Textures;
+				GetMaterialTextures(Material, Textures);
 
-					for (const auto& Expression : Material->GetMaterial()->GetExpressions())
+				for (const UTexture* Texture : Textures)
+				{
+					if (GetNameSafe(Texture).Contains(TextureName) == (Inclusivity == Include))
 					{
-						if (!Expression)
-						{
-							continue;
-						}
-
-						// Check if the Material Expression is a Texture Sample Expression.
-						if (Expression->IsA(UMaterialExpressionTextureSample::StaticClass()))
-						{
-							const UMaterialExpressionTextureSample* TextureSample = Cast<UMaterialExpressionTextureSample>(Expression);
-							if (TextureSample->Texture.GetName().Contains(TextureName) == (Inclusivity == Include))
-							{
-								FilteredActors.AddUnique(Actor);
-								break;
-							}
-						}
-
-						// Check if the Material Expression is a Texture Object instead of a Texture Sample.
-						if (Expression->IsA(UMaterialExpressionTextureObject::StaticClass()))
-						{
-							const UMaterialExpressionTextureObject* TextureObject = Cast<UMaterialExpressionTextureObject>(Expression);
-							if (TextureObject->Texture.GetName().Contains(TextureName) == (Inclusivity == Include))
-							{
-								FilteredActors.AddUnique(Actor);
-								break;
-							}
-						}
+						FilteredActors.AddUnique(Actor);
+						break;
 					}
 				}
 			}
 		}
 	}
 
-	UE_LOG(LogUDCoreEditor, Display, TEXT("Actor Filter: Found %i actors that %s texture name of %s"),
+	UE_LOG(LogUDCoreEditor, Display, TEXT("Actor Filter: Found %i actors that %s texture %s"),
 	       FilteredActors.Num(), Inclusivity == EUDInclusivity::Include ? TEXT("has") : TEXT("does not have"),
 	       *TextureName);
 }
@@ -971,97 +1333,45 @@ void UUDCoreEditorActorSubsystem::FilterActorsByTexture(
 	const EUDSearchLocation Source,
 	const EUDInclusivity Inclusivity)
 {
+	const UTexture2D* TextureToFind = TextureReference.LoadSynchronous();
+
 	for (AActor* Actor : Actors)
 	{
 		if (!Actor || FilteredActors.Contains(Actor)) { continue; }
 
-		TArray<UStaticMeshComponent*> StaticMeshComponents;
-		Actor->GetComponents<UStaticMeshComponent>(StaticMeshComponents, true);
+		TArray<const UPrimitiveComponent*> MeshComponents;
+		GetMeshComponents(Actor, MeshComponents);
 
-		for (const UStaticMeshComponent* StaticMeshComponent : StaticMeshComponents)
+		for (const UPrimitiveComponent* MeshComponent : MeshComponents)
 		{
-			if (!StaticMeshComponent)
-			{
-				continue;
-			}
-
-			if (Source == BaseAndOverride || Source == OverrideOnly)
-			{
-				for (UMaterialInterface* Material : StaticMeshComponent->GetMaterials())
-				{
-					if (!Material)
-					{
-						continue;
-					}
+			TArray<UMaterialInterface*> Materials;
+			GetMeshMaterials(MeshComponent, Source, Materials);
 
-					for (const auto& Expression : Material->GetMaterial()->GetExpressions())
-					{
-						if (!Expression)
-						{
-							continue;
-						}
-
-						// Check if the Material Expression is a Texture Sample Expression.
-						if (Expression->IsA(UMaterialExpressionTextureSample::StaticClass()))
-						{
-							const UMaterialExpressionTextureSample* TextureSample = Cast<UMaterialExpressionTextureSample>(Expression);
-							if (TextureSample->Texture == TextureReference == (Inclusivity == Include))
-							{
-								FilteredActors.AddUnique(Actor);
-								break;
-							}
-						}
-
-						// Check if the Material Expression is a Texture Object instead of a Texture Sample.
-						if (Expression->IsA(UMaterialExpressionTextureObject::StaticClass()))
-						{
-							const UMaterialExpressionTextureObject* TextureObject = Cast<UMaterialExpressionTextureObject>(Expression);
-							if (TextureObject->Texture == TextureReference == (Inclusivity == Include))
-							{
-								FilteredActors.AddUnique(Actor);
-								break;
-							}
-						}
-					}
-				}
-			}
-
-			if (Source == BaseAndOverride || Source == BaseOnly)
+			for (const UMaterialInterface* Material : Materials)
 			{
-				if (!StaticMeshComponent->GetStaticMesh())
+				if (!Material)
 				{
 					continue;
 				}
-				for (int32 i = 0; i < StaticMeshComponent->GetStaticMesh()->GetStaticMaterials().Num(); i++)
-				{
-					UMaterialInterface* Material = StaticMeshComponent->GetStaticMesh()->GetMaterial(i);
-					if (!Material)
-					{
-						continue;
-					}
 
-					for (const auto& Expression : Material->GetMaterial()->GetExpressions())
-					{
-						if (!Expression)
-						{
-							continue;
-						}
+				TArray<UTexture*> Textures;
+				GetMaterialTextures(Material, Textures);
 
-						// Check if the Material Expression
-						if (Expression->IsA(UMaterialExpressionTextureSample::StaticClass()))
-						{
-							const UMaterialExpressionTextureSample* TextureSample = Cast<UMaterialExpressionTextureSample>(Expression);
-							if (TextureSample->Texture == TextureReference == (Inclusivity == Include))
-							{
-								FilteredActors.AddUnique(Actor);
-								break;
-							}
-						}
+				for (const UTexture* Texture : Textures)
+				{
+					if ((Texture == TextureToFind) == (Inclusivity == Include))
+					{
+						FilteredActors.AddUnique(Actor);
+						break;
 					}
 				}
 			}
 		}
 	}
+
+	UE_LOG(LogUDCoreEditor, Display, TEXT("Actor Filter: Found %i actors that %s texture %s"),
+	       FilteredActors.Num(), Inclusivity == EUDInclusivity::Include ? TEXT("has") : TEXT("does not have"),
+	       *TextureReference.ToString());
 }
 
 void UUDCoreEditorActorSubsystem::FilterEmptyActors(
@@ -1172,6 +1482,106 @@ bool UUDCoreEditorActorSubsystem::IsActorWithinCapsuleBounds(AActor* Actor, UCap
 	return DeltaLoc <= CapsuleComponent->GetScaledCapsuleRadius() + CapsuleComponent->GetScaledCapsuleHalfHeight();
 }
 
+TArray<FUDCollisionProfile> UUDCoreEditorActorSubsystem::ProfileActorCollision(const TArray<AActor*>& Actors)
+{
+	TArray<FUDCollisionProfile> Profiles;
+
+	for (AActor* Actor : Actors)
+	{
+		if (!Actor) { continue; }
+
+		FUDCollisionProfile Profile;
+		Profile.Actor = Actor;
+
+		TArray<UPrimitiveComponent*> PrimitiveComponents;
+		Actor->GetComponents<UPrimitiveComponent>(PrimitiveComponents, true);
+
+		for (UPrimitiveComponent* PrimitiveComponent : PrimitiveComponents)
+		{
+			if (!PrimitiveComponent || !PrimitiveComponent->IsCollisionEnabled()) { continue; }
+
+			// Skeletal Mesh Components register one body per Physics Asset body, everything else uses its own body setup.
+			TArray<const UBodySetup*, TInlineAllocator<1>> BodySetups;
+			if (const USkeletalMeshComponent* SkeletalMeshComponent = Cast<USkeletalMeshComponent>(PrimitiveComponent))
+			{
+				if (const UPhysicsAsset* PhysicsAsset = SkeletalMeshComponent->GetPhysicsAsset())
+				{
+					for (const USkeletalBodySetup* SkeletalBodySetup : PhysicsAsset->SkeletalBodySetups)
+					{
+						BodySetups.Add(SkeletalBodySetup);
+					}
+				}
+			}
+			else
+			{
+				BodySetups.Add(PrimitiveComponent->GetBodySetup());
+			}
+
+			// Instanced Static Mesh Components register one body per instance.
+			const UInstancedStaticMeshComponent* InstancedComponent = Cast<UInstancedStaticMeshComponent>(PrimitiveComponent);
+			const int32 InstanceCount = InstancedComponent ? InstancedComponent->GetInstanceCount() : 1;
+
+			const bool bGeneratesOverlapEvents = PrimitiveComponent->GetGenerateOverlapEvents();
+			const float BroadphaseWeight =
+				(PrimitiveComponent->Mobility == EComponentMobility::Movable ? MovableBodyBroadphaseWeight : StaticBodyBroadphaseWeight) *
+				(bGeneratesOverlapEvents ? OverlapEventsBroadphaseMultiplier : 1.0f);
+
+			for (const UBodySetup* BodySetup : BodySetups)
+			{
+				if (!BodySetup || InstanceCount == 0) { continue; }
+
+				const FKAggregateGeom& AggGeom = BodySetup->AggGeom;
+				const int32 PrimitiveShapes = AggGeom.SphereElems.Num() + AggGeom.BoxElems.Num() + AggGeom.SphylElems.Num() + AggGeom.TaperedCapsuleElems.Num();
+				const int32 ConvexHulls = AggGeom.ConvexElems.Num();
+
+				int32 ConvexVertices = 0;
+				for (const FKConvexElem& ConvexElem : AggGeom.ConvexElems)
+				{
+					ConvexVertices += ConvexElem.VertexData.Num();
+				}
+
+				int32 ComplexTriangles = 0;
+				if (BodySetup->GetCollisionTraceFlag() == CTF_UseComplexAsSimple)
+				{
+					Profile.bUsesComplexAsSimple = true;
+					ComplexTriangles = GetComplexCollisionTriangleCount(PrimitiveComponent);
+				}
+
+				Profile.BodyCount += InstanceCount;
+				Profile.PrimitiveShapeCount += PrimitiveShapes * InstanceCount;
+				Profile.ConvexHullCount += ConvexHulls * InstanceCount;
+				Profile.ConvexVertexCount += ConvexVertices * InstanceCount;
+				Profile.ComplexTriangleCount += ComplexTriangles * InstanceCount;
+
+				Profile.BroadphaseCost += BroadphaseWeight * InstanceCount;
+				Profile.NarrowphaseCost += InstanceCount * (
+					PrimitiveShapes * PrimitiveShapeNarrowphaseWeight +
+					ConvexHulls * ConvexHullNarrowphaseWeight +
+					ConvexVertices * ConvexVertexNarrowphaseWeight +
+					ComplexTriangles * ComplexTriangleNarrowphaseWeight);
+			}
+
+			Profile.bGeneratesOverlapEvents |= bGeneratesOverlapEvents;
+		}
+
+		if (Profile.BodyCount == 0) { continue; }
+
+		Profile.EstimatedCost = Profile.BroadphaseCost + Profile.NarrowphaseCost;
+		Profiles.Add(Profile);
+	}
+
+	Profiles.Sort([](const FUDCollisionProfile& A, const FUDCollisionProfile& B)
+	{
+		return A.EstimatedCost > B.EstimatedCost;
+	});
+
+	UE_LOG(LogUDCoreEditor, Display, TEXT("Collision Profiler: Profiled %i actors with collision. Most expensive: %s (%f)."),
+	       Profiles.Num(), Profiles.IsEmpty() ? TEXT("None") : *Profiles[0].Actor->GetActorLabel(),
+	       Profiles.IsEmpty() ? 0.0f : Profiles[0].EstimatedCost);
+
+	return Profiles;
+}
+
 void UUDCoreEditorActorSubsystem::GetActorsByClass(
 	TArray<AActor*>& FoundActors,
 	const TSubclassOf<AActor> ActorClass,
@@ -1188,8 +1598,65 @@ void UUDCoreEditorActorSubsystem::GetActorsByName(
 	const EUDSelectionMethod SelectionMethod,
 	const EUDInclusivity Inclusivity)
 {
-	const TArray<AActor*> ActorsToFilter = SelectionMethod == Selection ? GetSelectedLevelActors() : GetAllLevelActors();
-	FilterActorsByName(ActorsToFilter, FoundActors, ActorName, Inclusivity);
+	if (SelectionMethod == Selection)
+	{
+		FilterActorsByName(GetSelectedLevelActors(), FoundActors, ActorName, Inclusivity);
+		return;
+	}
+
+	// Searching the whole level goes through the label index instead of comparing every actor label.
+	TArray<AActor*> MatchingActors;
+	GetActorLabelIndex().Find(ActorName, EUDLabelMatchMode::Substring, MatchingActors);
+
+	TSet<AActor*> AddedActors(FoundActors);
+	if (Inclusivity == Include)
+	{
+		for (AActor* Actor : MatchingActors)
+		{
+			bool bAlreadyAdded = false;
+			AddedActors.Add(Actor, &bAlreadyAdded);
+			if (!bAlreadyAdded) { FoundActors.Add(Actor); }
+		}
+	}
+	else
+	{
+		const TSet<AActor*> MatchingActorSet(MatchingActors);
+		for (AActor* Actor : GetAllLevelActors())
+		{
+			if (!Actor || MatchingActorSet.Contains(Actor)) { continue; }
+
+			bool bAlreadyAdded = false;
+			AddedActors.Add(Actor, &bAlreadyAdded);
+			if (!bAlreadyAdded) { FoundActors.Add(Actor); }
+		}
+	}
+
+	UE_LOG(
+		LogUDCoreEditor,
+		Display,
+		TEXT("Actor Filter: Found %i actors that does %s contain the name [%s]"),
+		FoundActors.Num(),
+		Inclusivity == EUDInclusivity::Include ? TEXT("") : TEXT("not"),
+		*ActorName);
+}
+
+void UUDCoreEditorActorSubsystem::GetActorsByLabelSearch(
+	TArray<AActor*>& FoundActors,
+	const FString& Query,
+	const EUDLabelMatchMode MatchMode)
+{
+	TArray<AActor*> MatchingActors;
+	GetActorLabelIndex().Find(Query, MatchMode, MatchingActors);
+
+	TSet<AActor*> AddedActors(FoundActors);
+	for (AActor* Actor : MatchingActors)
+	{
+		bool bAlreadyAdded = false;
+		AddedActors.Add(Actor, &bAlreadyAdded);
+		if (!bAlreadyAdded) { FoundActors.Add(Actor); }
+	}
+
+	UE_LOG(LogUDCoreEditor, Display, TEXT("Actor Filter: Found %i actors with a label matching [%s]"), FoundActors.Num(), *Query);
 }
 
 void UUDCoreEditorActorSubsystem::GetActorsByMaterial(
@@ -1340,41 +1807,8 @@ void UUDCoreEditorActorSubsystem::GetActorsByVertexCount(
 	const EUDSelectionMethod SelectionMethod,
 	const EUDInclusivity Inclusivity)
 {
-	TArray<AActor*> SourceActors = SelectionMethod == Selection ? GetSelectedLevelActors() : GetAllLevelActors();
-
-	for (AActor* Actor : SourceActors)
-	{
-		if (!Actor || FoundActors.Contains(Actor))
-		{
-			continue;
-		}
-
-		TArray<UStaticMeshComponent*> StaticMeshComponents;
-		Actor->GetComponents<UStaticMeshComponent>(StaticMeshComponents, true);
-
-		for (const UStaticMeshComponent* StaticMeshComponent : StaticMeshComponents)
-		{
-			if (!StaticMeshComponent)
-			{
-				continue;
-			}
-
-			const UStaticMesh* StaticMesh = StaticMeshComponent->GetStaticMesh();
-			if (!StaticMesh)
-			{
-				continue;
-			}
-
-			const int32 VertexCount = StaticMesh->GetNumVertices(0);
-			if ((VertexCount >= From && VertexCount <= To) == (Inclusivity == Include))
-			{
-				FoundActors.AddUnique(Actor);
-			}
-		}
-	}
-
-	UE_LOG(LogUDCoreEditor, Display, TEXT("%i actors with vertex count between %i and %i were found."),
-	       FoundActors.Num(), From, To);
+	const TArray<AActor*> ActorsToFilter = SelectionMethod == Selection ? GetSelectedLevelActors() : GetAllLevelActors();
+	FilterActorsByVertCount(ActorsToFilter, FoundActors, From, To, Inclusivity);
 }
 
 void UUDCoreEditorActorSubsystem::GetActorsByTriCount(
@@ -1384,42 +1818,8 @@ void UUDCoreEditorActorSubsystem::GetActorsByTriCount(
 	const EUDSelectionMethod SelectionMethod,
 	const EUDInclusivity Inclusivity)
 {
-	for (AActor* Actor : SelectionMethod == Selection ? GetSelectedLevelActors() : GetAllLevelActors())
-	{
-		if (!Actor || FoundActors.Contains(Actor))
-		{
-			continue;
-		}
-
-		TArray<UStaticMeshComponent*> StaticMeshComponents;
-		Actor->GetComponents<UStaticMeshComponent>(StaticMeshComponents, true);
-
-		for (const UStaticMeshComponent* StaticMeshComponent : StaticMeshComponents)
-		{
-			if (!StaticMeshComponent)
-			{
-				continue;
-			}
-			if (!StaticMeshComponent->GetStaticMesh())
-			{
-				continue;
-			}
-
-			const int32 TriCount = StaticMeshComponent->GetStaticMesh()->GetNumTriangles(0);
-
-			if ((TriCount >= From && TriCount <= To) == (Inclusivity == Include))
-			{
-				FoundActors.AddUnique(Actor);
-			}
-		}
-	}
-
-	UE_LOG(LogUDCoreEditor,
-		Display,
-		TEXT("%i actors with triangle count between %i and %i were found."),
-		FoundActors.Num(),
-		From,
-		To);
+	const TArray<AActor*> ActorsToFilter = SelectionMethod == Selection ? GetSelectedLevelActors() : GetAllLevelActors();
+	FilterActorsByTriCount(ActorsToFilter, FoundActors, From, To, Inclusivity);
 }
 
 void UUDCoreEditorActorSubsystem::GetActorsByBoundingBox(
@@ -1517,38 +1917,8 @@ void UUDCoreEditorActorSubsystem::GetActorsByLODCount(
 	const EUDSelectionMethod SelectionMethod,
 	const EUDInclusivity Inclusivity)
 {
-	for (AActor* Actor : SelectionMethod == Selection ? GetSelectedLevelActors() : GetAllLevelActors())
-	{
-		if (!Actor || FoundActors.Contains(Actor))
-		{
-			continue;
-		}
-		
-		TArray<UStaticMeshComponent*> StaticMeshComponents;
-		Actor->GetComponents<UStaticMeshComponent>(StaticMeshComponents, true);
-
-		for (const UStaticMeshComponent* StaticMeshComponent : StaticMeshComponents)
-		{
-			if (!StaticMeshComponent)
-			{
-				continue;
-			}
-
-			const UStaticMesh* StaticMesh = StaticMeshComponent->GetStaticMesh();
-			if (!StaticMesh)
-			{
-				continue;
-			}
-
-			if ((StaticMesh->GetNumLODs() >= LODCountFrom && StaticMesh->GetNumLODs() <= LODCountTo) == (Inclusivity == Include))
-			{
-				FoundActors.AddUnique(Actor);
-			}
-		}
-	}
-
-	UE_LOG(LogUDCoreEditor, Display, TEXT("%i actors with LOD count between %i and %i were found."),
-	       FoundActors.Num(), LODCountFrom, LODCountTo);
+	const TArray<AActor*> ActorsToFilter = SelectionMethod == Selection ? GetSelectedLevelActors() : GetAllLevelActors();
+	FilterActorsByLODCount(ActorsToFilter, FoundActors, LODCountFrom, LODCountTo, Inclusivity);
 }
 
 void UUDCoreEditorActorSubsystem::GetActorsByNaniteEnabled(
@@ -1951,3 +2321,224 @@ void UUDCoreEditorActorSubsystem::PushOverrideMaterialsToSource(UStaticMeshCompo
 	}
 	UE_LOG(LogUDCoreEditor, Display, TEXT("Materials were pushed to source for %s."), *StaticMeshComponent->GetName());
 }
+
+TArray<UStaticMesh*> UUDCoreEditorActorSubsystem::GetUniqueStaticMeshes(const TArray<AActor*>& Actors)
+{
+	TArray<UStaticMesh*> StaticMeshes;
+	TSet<UStaticMesh*> VisitedStaticMeshes;
+
+	for (const AActor* Actor : Actors)
+	{
+		if (!Actor) { continue; }
+
+		TArray<UStaticMeshComponent*> StaticMeshComponents;
+		Actor->GetComponents<UStaticMeshComponent>(StaticMeshComponents, true);
+
+		for (const UStaticMeshComponent* StaticMeshComponent : StaticMeshComponents)
+		{
+			if (!StaticMeshComponent) { continue; }
+
+			UStaticMesh* StaticMesh = StaticMeshComponent->GetStaticMesh();
+			if (!IsValid(StaticMesh)) { continue; }
+
+			bool bAlreadyVisited = false;
+			VisitedStaticMeshes.Add(StaticMesh, &bAlreadyVisited);
+			if (!bAlreadyVisited)
+			{
+				StaticMeshes.Add(StaticMesh);
+			}
+		}
+	}
+
+	return StaticMeshes;
+}
+
+FUDNaniteBatchReport UUDCoreEditorActorSubsystem::EnableNaniteOnActors(
+	const TArray<AActor*>& Actors,
+	const FUDNaniteBatchSettings& Settings)
+{
+	FUDNaniteBatchReport Report;
+
+	TArray<UStaticMesh*> StaticMeshes = GetUniqueStaticMeshes(Actors);
+	Report.SkippedMeshes = StaticMeshes.RemoveAll([](const UStaticMesh* StaticMesh)
+	{
+		return StaticMesh->NaniteSettings.bEnabled;
+	});
+
+	if (StaticMeshes.IsEmpty())
+	{
+		UE_LOG(LogUDCoreEditor, Display, TEXT("Nanite: No Static Meshes without Nanite were found."));
+		return Report;
+	}
+
+	const FScopedTransaction Transaction(LOCTEXT("EnableNaniteOnActors", "Enable Nanite on Static Meshes"));
+	FScopedSlowTask SlowTask(StaticMeshes.Num(), LOCTEXT("EnableNaniteOnActorsProgress", "Enabling Nanite on Static Meshes..."));
+	SlowTask.MakeDialog(true);
+
+	TMap<UStaticMesh*, int32> ReportIndices;
+	ReportIndices.Reserve(StaticMeshes.Num());
+	Report.Meshes.Reserve(StaticMeshes.Num());
+
+	const bool bCompleted = BatchBuildStaticMeshes(
+		StaticMeshes,
+		Settings.MaxConcurrentBuilds,
+		SlowTask,
+		[&Report, &ReportIndices, &Settings](UStaticMesh* StaticMesh)
+		{
+			FUDNaniteMeshReport& MeshReport = Report.Meshes.AddDefaulted_GetRef();
+			MeshReport.StaticMesh = StaticMesh;
+			MeshReport.TrianglesBefore = StaticMesh->GetNumTriangles(0);
+			MeshReport.ResourceSizeBefore = StaticMesh->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+			ReportIndices.Add(StaticMesh, Report.Meshes.Num() - 1);
+
+			StaticMesh->Modify();
+			StaticMesh->NaniteSettings.bEnabled = true;
+			StaticMesh->NaniteSettings.KeepPercentTriangles = Settings.KeepPercentTriangles;
+			StaticMesh->NaniteSettings.FallbackPercentTriangles = Settings.FallbackPercentTriangles;
+			StaticMesh->NaniteSettings.bPreserveArea = Settings.bPreserveArea;
+		},
+		[&Report, &ReportIndices](UStaticMesh* StaticMesh)
+		{
+			FUDNaniteMeshReport& MeshReport = Report.Meshes[ReportIndices.FindChecked(StaticMesh)];
+			MeshReport.TrianglesAfter = StaticMesh->HasValidNaniteData() ? StaticMesh->GetNumNaniteTriangles() : StaticMesh->GetNumTriangles(0);
+			MeshReport.ResourceSizeAfter = StaticMesh->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		});
+
+	Report.bCancelled = !bCompleted;
+
+	int64 TrianglesBefore = 0;
+	int64 TrianglesAfter = 0;
+	int64 ResourceSizeBefore = 0;
+	int64 ResourceSizeAfter = 0;
+	for (const FUDNaniteMeshReport& MeshReport : Report.Meshes)
+	{
+		TrianglesBefore += MeshReport.TrianglesBefore;
+		TrianglesAfter += MeshReport.TrianglesAfter;
+		ResourceSizeBefore += MeshReport.ResourceSizeBefore;
+		ResourceSizeAfter += MeshReport.ResourceSizeAfter;
+	}
+
+	UE_LOG(LogUDCoreEditor, Display,
+	       TEXT("Nanite: Enabled Nanite on %i Static Meshes (%i skipped%s). Triangles: %lld -> %lld. Resource size: %.2f MB -> %.2f MB."),
+	       Report.Meshes.Num(), Report.SkippedMeshes, Report.bCancelled ? TEXT(", cancelled") : TEXT(""),
+	       TrianglesBefore, TrianglesAfter,
+	       ResourceSizeBefore / (1024.0 * 1024.0), ResourceSizeAfter / (1024.0 * 1024.0));
+
+	return Report;
+}
+
+TArray<FUDLODMeshReport> UUDCoreEditorActorSubsystem::GenerateLODsOnActors(
+	const TArray<AActor*>& Actors,
+	const FUDLODGenerationSettings& Settings)
+{
+	TArray<FUDLODMeshReport> Reports;
+
+	if (Settings.LODs.IsEmpty())
+	{
+		UE_LOG(LogUDCoreEditor, Warning, TEXT("LOD Generation: No LOD presets were provided."));
+		return Reports;
+	}
+
+	const int32 TargetLODCount = Settings.LODs.Num() + 1;
+	const TArray<UStaticMesh*> StaticMeshes = GetUniqueStaticMeshes(Actors);
+
+	TArray<UStaticMesh*> MeshesToBuild;
+	TMap<UStaticMesh*, int32> ReportIndices;
+	Reports.Reserve(StaticMeshes.Num());
+
+	for (UStaticMesh* StaticMesh : StaticMeshes)
+	{
+		FUDLODMeshReport& Report = Reports.AddDefaulted_GetRef();
+		Report.StaticMesh = StaticMesh;
+		Report.LODCountBefore = StaticMesh->GetNumLODs();
+		Report.LODCountAfter = Report.LODCountBefore;
+		Report.TrianglesLOD0 = Report.LODCountBefore > 0 ? StaticMesh->GetNumTriangles(0) : 0;
+		Report.TrianglesLastLOD = Report.LODCountBefore > 0 ? StaticMesh->GetNumTriangles(Report.LODCountBefore - 1) : 0;
+
+		// Meshes matching the presets were generated by a previous run, which is what makes the batch resumable.
+		if (HasMatchingLODs(StaticMesh, Settings.LODs))
+		{
+			Report.Status = EUDLODGenerationStatus::AlreadyGenerated;
+			continue;
+		}
+
+		if (StaticMesh->NaniteSettings.bEnabled || (Settings.bSkipMeshesWithEnoughLODs && Report.LODCountBefore >= TargetLODCount))
+		{
+			Report.Status = EUDLODGenerationStatus::Skipped;
+			continue;
+		}
+
+		// Setting the source models would discard the custom LODs, so they are only replaced when the caller opts in.
+		if (!Settings.bOverwriteCustomLODs && HasCustomLODs(StaticMesh))
+		{
+			Report.Status = EUDLODGenerationStatus::HasCustomLODs;
+			continue;
+		}
+
+		ReportIndices.Add(StaticMesh, Reports.Num() - 1);
+		MeshesToBuild.Add(StaticMesh);
+	}
+
+	if (MeshesToBuild.IsEmpty())
+	{
+		UE_LOG(LogUDCoreEditor, Display, TEXT("LOD Generation: None of the %i Static Meshes needed new LODs."), Reports.Num());
+		return Reports;
+	}
+
+	const FScopedTransaction Transaction(LOCTEXT("GenerateLODsOnActors", "Generate Static Mesh LODs"));
+	FScopedSlowTask SlowTask(MeshesToBuild.Num(), LOCTEXT("GenerateLODsOnActorsProgress", "Generating Static Mesh LODs..."));
+	SlowTask.MakeDialog(true);
+
+	const bool bCompleted = BatchBuildStaticMeshes(
+		MeshesToBuild,
+		Settings.MaxConcurrentBuilds,
+		SlowTask,
+		[&Settings, TargetLODCount](UStaticMesh* StaticMesh)
+		{
+			StaticMesh->Modify();
+			StaticMesh->bAutoComputeLODScreenSize = false;
+			StaticMesh->SetNumSourceModels(TargetLODCount);
+			StaticMesh->GetSourceModel(0).ScreenSize.Default = 1.0f;
+
+			for (int32 Index = 0; Index < Settings.LODs.Num(); ++Index)
+			{
+				// Custom LODs are only reached here when overwriting them was requested. Their mesh takes precedence over the reduction, so it is cleared.
+				if (StaticMesh->IsMeshDescriptionValid(Index + 1))
+				{
+					StaticMesh->ClearMeshDescription(Index + 1);
+				}
+
+				FStaticMeshSourceModel& SourceModel = StaticMesh->GetSourceModel(Index + 1);
+				SourceModel.ReductionSettings.BaseLODModel = 0;
+				SourceModel.ReductionSettings.PercentTriangles = Settings.LODs[Index].PercentTriangles;
+				SourceModel.ScreenSize.Default = Settings.LODs[Index].ScreenSize;
+			}
+		},
+		[&Reports, &ReportIndices, &Settings](UStaticMesh* StaticMesh)
+		{
+			FUDLODMeshReport& Report = Reports[ReportIndices.FindChecked(StaticMesh)];
+			Report.LODCountAfter = StaticMesh->GetNumLODs();
+			Report.TrianglesLastLOD = Report.LODCountAfter > 0 ? StaticMesh->GetNumTriangles(Report.LODCountAfter - 1) : 0;
+
+			// Only report the mesh as generated if its last LOD was actually reduced from LOD0.
+			const bool bReduced = !HasCustomLODs(StaticMesh) && Report.LODCountAfter == Settings.LODs.Num() + 1 &&
+				(Report.TrianglesLastLOD < Report.TrianglesLOD0 || Settings.LODs.Last().PercentTriangles >= 1.0f);
+			Report.Status = bReduced ? EUDLODGenerationStatus::Generated : EUDLODGenerationStatus::Failed;
+			if (!bReduced)
+			{
+				UE_LOG(LogUDCoreEditor, Warning, TEXT("LOD Generation: %s was built but its LODs were not reduced from LOD0."), *StaticMesh->GetName());
+			}
+		});
+
+	const int32 GeneratedCount = Reports.FilterByPredicate([](const FUDLODMeshReport& Report)
+	{
+		return Report.Status == EUDLODGenerationStatus::Generated;
+	}).Num();
+
+	UE_LOG(LogUDCoreEditor, Display, TEXT("LOD Generation: Generated %i LODs on %i of %i Static Meshes%s."),
+	       Settings.LODs.Num(), GeneratedCount, Reports.Num(), bCompleted ? TEXT("") : TEXT(" (cancelled)"));
+
+	return Reports;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,73 @@
+﻿// Copyright Unreal Directive. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UDCoreEditorTypes.h"
+
+class AActor;
+
+/**
+ * FUDCoreActorLabelIndex
+ *
+ * A case-insensitive trigram index over actor labels.
+ * Searches only verify the labels sharing the rarest trigram of the query instead of every indexed label.
+ * Queries shorter than three characters and regular expressions have no usable trigrams and verify every cached label.
+ */
+class UDCOREEDITOR_API FUDCoreActorLabelIndex
+{
+public:
+
+	/** Removes every actor from the index. */
+	void Reset();
+
+	/** Returns the number of actors in the index. */
+	int32 Num() const { return EntryIndices.Num(); }
+
+	/** Returns true if the actor is in the index. */
+	bool Contains(const AActor* Actor) const { return EntryIndices.Contains(Actor); }
+
+	/**
+	 * Adds the actor to the index, or re-indexes its label if it is already in the index.
+	 * @param Actor The actor to index.
+	 */
+	void AddActor(AActor* Actor);
+
+	/**
+	 * Removes the actor from the index.
+	 * @param Actor The actor to remove.
+	 */
+	void RemoveActor(const AActor* Actor);
+
+	/**
+	 * Finds the indexed actors whose label matches the query.
+	 * @param Query The text, wildcard pattern or regular expression to match. Matching is case-insensitive.
+	 * @param MatchMode How the query is matched against the labels.
+	 * @param OutActors The actors whose label matches the query.
+	 */
+	void Find(const FString& Query, EUDLabelMatchMode MatchMode, TArray<AActor*>& OutActors) const;
+
+private:
+
+	struct FEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FString Label;
+	};
+
+	/** Returns the unique trigrams of the provided lower-case text. */
+	static void GetTrigrams(FStringView Text, TArray<uint64, TInlineAllocator<64>>& OutTrigrams);
+
+	/**
+	 * Gathers the entries that may contain the provided lower-case literal.
+	 * @returns False if the literal is too short to use the index, in which case every entry is a candidate.
+	 */
+	bool GatherCandidates(FStringView Literal, TArray<int32>& OutCandidates) const;
+
+	void RemoveEntry(int32 EntryIndex);
+
+	TArray<FEntry> Entries;
+	TArray<int32> FreeEntries;
+	TMap<FObjectKey, int32> EntryIndices;
+	TMap<uint64, TArray<int32>> Trigrams;
+};
@@ -10,9 +10,12 @@
 #include "Subsystems/EditorActorSubsystem.h"
 #include "Engine/EngineTypes.h"
 #include "UDCoreEditorTypes.h"
+#include "Search/UDCoreActorLabelIndex.h"
 #include "UDCoreEditorActorSubsystem.generated.h"
 
 class UCapsuleComponent;
+class ULevel;
+class UWorldPartition;
 
 /**
  * UDCoreEditorActorSubsystem
@@ -26,6 +29,9 @@ class UDCOREEDITOR_API UUDCoreEditorActorSubsystem : public UEditorActorSubsyste
 
 public:
 
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
 	//-----------------------------
 	// Utilities
 	//-----------------------------
@@ -44,6 +50,13 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Unreal Directive Toolkit|Editor")
 	TArray<UClass*> GetAllLevelClasses();
+
+	/**
+	 * Rebuilds the cached actor label index used by label searches.
+	 * The index is updated automatically, this is only needed if labels were changed without notifying the editor.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Unreal Directive Toolkit|Editor")
+	void RebuildActorLabelIndex();
 	
 	//-----------------------------
 	// Filters
@@ -58,6 +71,7 @@ public:
 
 	/**
 	 * Filters the provided actors based on the provided name.
+	 * Actors of the editor world are matched through the actor label index when it is up to date and they are a large share of the world.
 	 * @param Actors The list of actors to filter.
 	 * @param FilteredActors The list of actors that have been filtered.
 	 * @param ActorName The name to filter by.
@@ -88,6 +102,7 @@ public:
 
 	/**
 	 * Filter the provided actors based on the provided material name.
+	 * Checks Static Mesh, Skeletal Mesh and Niagara components.
 	 * @param Actors The list of actors to filter.
 	 * @param FilteredActors The list of actors that have been filtered.
 	 * @param MaterialName The material name to filter by.
@@ -99,6 +114,7 @@ public:
 	
 	/**
 	 * Filter the provided actors based on the provided material reference.
+	 * Checks Static Mesh, Skeletal Mesh and Niagara components.
 	 * @param Actors The list of actors to filter.
 	 * @param FilteredActors The list of actors that have been filtered.
 	 * @param Material The material reference to filter by.
@@ -130,6 +146,7 @@ public:
 
 	/**
 	 * Filter the provided actors based on the provided vert count range.
+	 * Checks Static Mesh and Skeletal Mesh components. Niagara components have no fixed geometry and are ignored.
 	 * @param Actors The list of actors to filter.
 	 * @param FilteredActors The list of actors that have been filtered.
 	 * @param MinVertCount The minimum vert count to filter by.
@@ -141,6 +158,7 @@ public:
 
 	/**
 	 * Filter the provided actors based on the provided triangle count range.
+	 * Checks Static Mesh and Skeletal Mesh components. Niagara components have no fixed geometry and are ignored.
 	 * @param Actors The list of actors to filter.
 	 * @param FilteredActors The list of actors that have been filtered.
 	 * @param MinTriCount The minimum triangle count to filter by.
@@ -172,6 +190,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Unreal Directive Toolkit|Filters|Actor")
 	static void FilterActorsByStaticMeshBounds(const TArray<AActor*>& Actors, TArray<AActor*>& FilteredActors, const FVector& MinBounds, const FVector& MaxBounds, EUDInclusivity Inclusivity = EUDInclusivity::Include);
 
+	/**
+	 * Filter the provided actors based on the bounds of their meshes.
+	 * Checks Static Mesh, Skeletal Mesh and Niagara components.
+	 * @param Actors The list of actors to filter.
+	 * @param FilteredActors The list of actors that have been filtered.
+	 * @param MinBounds The minimum bounds to filter by.
+	 * @param MaxBounds The maximum bounds to filter by.
+	 * @param Inclusivity Whether to include or exclude actors with the provided bounds.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Unreal Directive Toolkit|Filters|Actor")
+	static void FilterActorsByMeshBounds(const TArray<AActor*>& Actors, TArray<AActor*>& FilteredActors, const FVector& MinBounds, const FVector& MaxBounds, EUDInclusivity Inclusivity = EUDInclusivity::Include);
+
 	/**
 	 * Filter the provided actors based on the provided world location and radius.
 	 * @param Actors The list of actors to filter.
@@ -185,6 +215,7 @@ public:
 
 	/**
 	 * Filter the provided actors based on the provided LOD (Level of Detail) count.
+	 * Checks Static Mesh and Skeletal Mesh components. Niagara components have no fixed geometry and are ignored.
 	 * @param Actors The list of actors to filter.
 	 * @param FilteredActors The list of actors that have been filtered.
 	 * @param MinLODs The minimum LOD count to filter by.
@@ -269,6 +300,7 @@ public:
 
 	/**
 	 * Filter the provided actors based on the provided Texture Name.
+	 * Checks Static Mesh, Skeletal Mesh and Niagara components.
 	 * @param Actors The list of actors to filter.
 	 * @param FilteredActors The list of actors that have been filtered.
 	 * @param TextureName The texture name to filter by.
@@ -280,6 +312,7 @@ public:
 
 	/**
 	 * Filter the provided actors based on the provided Texture Reference.
+	 * Checks Static Mesh, Skeletal Mesh and Niagara components.
 	 * @param Actors The list of actors to filter.
 	 * @param FilteredActors The list of actors that have been filtered.
 	 * @param TextureReference The texture reference to filter by.
@@ -356,6 +389,19 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Unreal Directive Toolkit")
 	static bool IsActorWithinCapsuleBounds(AActor* Actor, UCapsuleComponent* CapsuleComponent);
 
+	//-----------------------------
+	// Collision
+	//-----------------------------
+
+	/**
+	 * Profiles the collision complexity of the provided actors and ranks them by estimated physics cost.
+	 * Typically used on the result of the collision filters to find the actors that cost the most physics time.
+	 * @param Actors The actors to profile.
+	 * @returns The collision profile of every actor with collision enabled, sorted from the most to the least expensive.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Unreal Directive Toolkit|Collision")
+	static TArray<FUDCollisionProfile> ProfileActorCollision(const TArray<AActor*>& Actors);
+
 	//-----------------------------
 	// Getters
 	//-----------------------------
@@ -389,6 +435,19 @@ public:
 		EUDSelectionMethod SelectionMethod = EUDSelectionMethod::World,
 		EUDInclusivity Inclusivity = EUDInclusivity::Include);
 
+	/**
+	 * Returns the actors in the level whose label matches the provided query.
+	 * Uses a cached label index that is updated as actors are added, deleted or renamed, so searches stay fast on large levels.
+	 * @param FoundActors The list of actors that were found.
+	 * @param Query The text, wildcard pattern or regular expression to search for. Matching is case-insensitive.
+	 * @param MatchMode How the query is matched against the actor labels.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Unreal Directive Toolkit|Select", meta=(AdvancedDisplay=2))
+	void GetActorsByLabelSearch(
+		TArray<AActor*>& FoundActors,
+		const FString& Query,
+		EUDLabelMatchMode MatchMode = EUDLabelMatchMode::Substring);
+
 	/**
 	 * Returns a list of actors based on the provided material reference and options.
 	 * Note: This will only return actors that have a static mesh component.
@@ -442,7 +501,7 @@ public:
 
 	/**
 	* Returns a list of actors based on the provided vert count and options.
-	* Note: This will only return actors that have a Static Mesh Component.
+	* Note: This will only return actors that have a Static Mesh or Skeletal Mesh Component.
 	* @param FoundActors The list of actors that were found.
 	* @param From The minimum number of vertices to search for.
 	* @param To	The maximum number of vertices to search for.
@@ -459,7 +518,7 @@ public:
 
 	/**
 	* Returns a list of actors based on the provided triangle count and options.
-	* Note: This will only return actors that have a Static Mesh Component.
+	* Note: This will only return actors that have a Static Mesh or Skeletal Mesh Component.
 	* @param FoundActors The list of actors that were found.
 	* @param From The minimum number of vertices to search for.
 	* @param To	The maximum number of vertices to search for.
@@ -524,6 +583,7 @@ public:
 
 	/**
 	 * Returns a list of actors based on the provided LOD count and options.
+	 * Note: This will only return actors that have a Static Mesh or Skeletal Mesh Component.
 	 * @param FoundActors The list of actors that were found.
 	 * @param From The minimum number of LODs to search for.
 	 * @param To The maximum number of LODs to search for.
@@ -684,4 +744,75 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Unreal Directive Toolkit|Static Mesh")
 	static void PushOverrideMaterialsToSource(UStaticMeshComponent* StaticMeshComponent);
+
+	/**
+	 * Returns the unique Static Meshes used by the Static Mesh Components of the provided actors.
+	 * @param Actors The actors to gather the Static Meshes from.
+	 * @returns The unique list of Static Meshes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Unreal Directive Toolkit|Static Mesh")
+	static TArray<UStaticMesh*> GetUniqueStaticMeshes(const TArray<AActor*>& Actors);
+
+	/**
+	 * Enables Nanite on every unique Static Mesh used by the provided actors and rebuilds them in parallel.
+	 * Static Meshes that already have Nanite enabled are left untouched.
+	 * The whole operation is recorded as a single undoable transaction.
+	 * @param Actors The actors whose Static Meshes should be converted. Typically the result of FilterActorsByNaniteState.
+	 * @param Settings The Nanite settings to apply and the build concurrency to use.
+	 * @returns The before and after statistics of every converted Static Mesh.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Unreal Directive Toolkit|Static Mesh")
+	static FUDNaniteBatchReport EnableNaniteOnActors(const TArray<AActor*>& Actors, const FUDNaniteBatchSettings& Settings);
+
+	/**
+	 * Generates reduced LODs on every unique Static Mesh used by the provided actors and rebuilds them in parallel.
+	 * Meshes that already match the requested LODs are not rebuilt, so running it again after a cancelled batch resumes where it stopped.
+	 * Meshes with imported or hand-authored LODs are left untouched unless the settings allow overwriting them.
+	 * The whole operation is recorded as a single undoable transaction.
+	 * @param Actors The actors whose Static Meshes should receive LODs. Typically the result of FilterActorsByLODCount.
+	 * @param Settings The LOD presets to generate and the build concurrency to use.
+	 * @returns The result of the generation for every unique Static Mesh.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Unreal Directive Toolkit|Static Mesh")
+	static TArray<FUDLODMeshReport> GenerateLODsOnActors(const TArray<AActor*>& Actors, const FUDLODGenerationSettings& Settings);
+
+private:
+
+	/** Returns the actor label index of the editor world, rebuilding it first if it is out of date. */
+	const FUDCoreActorLabelIndex& GetActorLabelIndex();
+
+	/** Returns true if the actor belongs to the world covered by an up to date actor label index. */
+	bool IsActorInLabelIndexWorld(const AActor* Actor) const;
+
+	/** Binds the actor label index to the World Partition loading events of its world, so loaded and unloaded actors mark it out of date. */
+	void BindWorldPartitionEvents(UWorld* World);
+
+	void OnActorLabelChanged(AActor* Actor);
+	void OnLevelActorAdded(AActor* Actor);
+	void OnLevelActorDeleted(AActor* Actor);
+	void OnLevelsChanged(ULevel* Level, UWorld* World);
+	void OnMapChanged(uint32 MapChangeFlags);
+	void OnActorListChanged();
+
+	/** The cached label index of the editor world's actors. */
+	FUDCoreActorLabelIndex ActorLabelIndex;
+
+	/** The world the actor label index was built from. */
+	TWeakObjectPtr<UWorld> ActorLabelIndexWorld;
+
+	/** True if the actor label index must be rebuilt before its next use. */
+	bool bActorLabelIndexDirty = true;
+
+	FDelegateHandle ActorLabelChangedHandle;
+	FDelegateHandle LevelActorAddedHandle;
+	FDelegateHandle LevelActorDeletedHandle;
+	FDelegateHandle LevelAddedToWorldHandle;
+	FDelegateHandle LevelRemovedFromWorldHandle;
+	FDelegateHandle MapChangeHandle;
+	FDelegateHandle PostUndoRedoHandle;
+	FDelegateHandle LevelActorListChangedHandle;
+	FDelegateHandle LoaderAdapterStateChangedHandle;
+
+	/** The World Partition whose loading events are bound. */
+	TWeakObjectPtr<UWorldPartition> BoundWorldPartition;
 };
\ No newline at end of file
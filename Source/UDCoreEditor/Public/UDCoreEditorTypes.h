@@ -3,6 +3,10 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "UDCoreEditorTypes.generated.h"
+
+class AActor;
+class UStaticMesh;
 
 /**
  * EUDSelectionMethod
@@ -39,4 +43,264 @@ enum EUDSearchLocation : uint8
  BaseAndOverride UMETA(DisplayName = "Base & Override", Tooltip="With search the base object along with actor overrides."),
  BaseOnly UMETA(DisplayName = "Base Only", Tooltip="Will only search the base object."),
  OverrideOnly UMETA(DisplayName = "Override Only", Tooltip="Will only search actor overrides."),
-};
\ No newline at end of file
+};
+
+/**
+ * EUDLabelMatchMode
+ *
+ * How a label search query is matched against actor labels.
+ */
+UENUM(BlueprintType)
+enum class EUDLabelMatchMode : uint8
+{
+	Prefix UMETA(Tooltip="Match labels starting with the query."),
+	Substring UMETA(Tooltip="Match labels containing the query."),
+	Wildcard UMETA(Tooltip="Match labels against a wildcard pattern using * and ?."),
+	Regex UMETA(DisplayName="Regular Expression", Tooltip="Match labels against a regular expression."),
+};
+
+/**
+ * FUDNaniteBatchSettings
+ *
+ * The Nanite settings applied to each Static Mesh by the batch Nanite enablement.
+ */
+USTRUCT(BlueprintType)
+struct FUDNaniteBatchSettings
+{
+	GENERATED_BODY()
+
+	/** The percentage of triangles to keep from the source mesh. 1.0 keeps every triangle. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Nanite", meta=(ClampMin=0, ClampMax=1))
+	float KeepPercentTriangles = 1.0f;
+
+	/** The percentage of triangles to keep in the fallback mesh used when Nanite is unavailable. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Nanite", meta=(ClampMin=0, ClampMax=1))
+	float FallbackPercentTriangles = 1.0f;
+
+	/** Enable to preserve the surface area of the mesh when simplifying. Useful for foliage. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Nanite")
+	bool bPreserveArea = false;
+
+	/** The maximum number of meshes that can be building at once. 0 will use the number of available cores. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Build", meta=(ClampMin=0))
+	int32 MaxConcurrentBuilds = 0;
+};
+
+/**
+ * FUDNaniteMeshReport
+ *
+ * The before and after statistics of a single Static Mesh converted to Nanite.
+ */
+USTRUCT(BlueprintType)
+struct FUDNaniteMeshReport
+{
+	GENERATED_BODY()
+
+	/** The Static Mesh that was converted. */
+	UPROPERTY(BlueprintReadOnly, Category = "Nanite")
+	TSoftObjectPtr<UStaticMesh> StaticMesh;
+
+	/** The LOD0 triangle count before the conversion. */
+	UPROPERTY(BlueprintReadOnly, Category = "Nanite")
+	int32 TrianglesBefore = 0;
+
+	/** The Nanite triangle count after the conversion. */
+	UPROPERTY(BlueprintReadOnly, Category = "Nanite")
+	int32 TrianglesAfter = 0;
+
+	/** The estimated resource size in bytes before the conversion. */
+	UPROPERTY(BlueprintReadOnly, Category = "Nanite")
+	int64 ResourceSizeBefore = 0;
+
+	/** The estimated resource size in bytes after the conversion. */
+	UPROPERTY(BlueprintReadOnly, Category = "Nanite")
+	int64 ResourceSizeAfter = 0;
+};
+
+/**
+ * FUDNaniteBatchReport
+ *
+ * The result of a batch Nanite enablement.
+ */
+USTRUCT(BlueprintType)
+struct FUDNaniteBatchReport
+{
+	GENERATED_BODY()
+
+	/** The per mesh statistics of every converted Static Mesh. */
+	UPROPERTY(BlueprintReadOnly, Category = "Nanite")
+	TArray<FUDNaniteMeshReport> Meshes;
+
+	/** The number of Static Meshes that already had Nanite enabled and were left untouched. */
+	UPROPERTY(BlueprintReadOnly, Category = "Nanite")
+	int32 SkippedMeshes = 0;
+
+	/** True if the batch was cancelled before every mesh was converted. */
+	UPROPERTY(BlueprintReadOnly, Category = "Nanite")
+	bool bCancelled = false;
+};
+
+/**
+ * FUDCollisionProfile
+ *
+ * The collision complexity of a single actor and its estimated physics cost.
+ * The costs are relative heuristics intended for ranking actors against each other, not absolute timings.
+ */
+USTRUCT(BlueprintType)
+struct FUDCollisionProfile
+{
+	GENERATED_BODY()
+
+	/** The profiled actor. */
+	UPROPERTY(BlueprintReadOnly, Category = "Collision")
+	TObjectPtr<AActor> Actor = nullptr;
+
+	/** The number of physics bodies the actor registers, including one per instance for instanced components. */
+	UPROPERTY(BlueprintReadOnly, Category = "Collision")
+	int32 BodyCount = 0;
+
+	/** The number of sphere, box and capsule shapes across all bodies. */
+	UPROPERTY(BlueprintReadOnly, Category = "Collision")
+	int32 PrimitiveShapeCount = 0;
+
+	/** The number of convex hulls across all bodies. */
+	UPROPERTY(BlueprintReadOnly, Category = "Collision")
+	int32 ConvexHullCount = 0;
+
+	/** The total number of convex hull vertices across all bodies. */
+	UPROPERTY(BlueprintReadOnly, Category = "Collision")
+	int32 ConvexVertexCount = 0;
+
+	/** The number of triangles used as simple collision by bodies using complex as simple. */
+	UPROPERTY(BlueprintReadOnly, Category = "Collision")
+	int32 ComplexTriangleCount = 0;
+
+	/** True if any body of the actor uses its complex collision as simple collision. */
+	UPROPERTY(BlueprintReadOnly, Category = "Collision")
+	bool bUsesComplexAsSimple = false;
+
+	/** True if any collision enabled component of the actor generates overlap events. */
+	UPROPERTY(BlueprintReadOnly, Category = "Collision")
+	bool bGeneratesOverlapEvents = false;
+
+	/** The estimated broadphase cost, driven by the body count, mobility and overlap events. */
+	UPROPERTY(BlueprintReadOnly, Category = "Collision")
+	float BroadphaseCost = 0.0f;
+
+	/** The estimated narrowphase cost, driven by the shape count and complexity. */
+	UPROPERTY(BlueprintReadOnly, Category = "Collision")
+	float NarrowphaseCost = 0.0f;
+
+	/** The sum of the broadphase and narrowphase costs, used for ranking. */
+	UPROPERTY(BlueprintReadOnly, Category = "Collision")
+	float EstimatedCost = 0.0f;
+};
+
+/**
+ * FUDLODPreset
+ *
+ * The screen size and reduction of a single generated LOD.
+ */
+USTRUCT(BlueprintType)
+struct FUDLODPreset
+{
+	GENERATED_BODY()
+
+	/** The screen size at which the LOD becomes visible. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta=(ClampMin=0, ClampMax=1))
+	float ScreenSize = 0.5f;
+
+	/** The percentage of triangles of the base mesh to keep in the LOD. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta=(ClampMin=0, ClampMax=1))
+	float PercentTriangles = 0.5f;
+
+	FUDLODPreset() = default;
+
+	FUDLODPreset(const float InScreenSize, const float InPercentTriangles)
+		: ScreenSize(InScreenSize)
+		, PercentTriangles(InPercentTriangles)
+	{
+	}
+};
+
+/**
+ * FUDLODGenerationSettings
+ *
+ * The LODs generated by the batch LOD generation and the build concurrency to use.
+ */
+USTRUCT(BlueprintType)
+struct FUDLODGenerationSettings
+{
+	GENERATED_BODY()
+
+	/** The LODs to generate after LOD0, in order. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	TArray<FUDLODPreset> LODs = {
+		FUDLODPreset(0.5f, 0.5f),
+		FUDLODPreset(0.25f, 0.25f),
+		FUDLODPreset(0.1f, 0.125f),
+	};
+
+	/** Enable to leave meshes that already have at least as many LODs as requested untouched. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	bool bSkipMeshesWithEnoughLODs = true;
+
+	/** Enable to replace imported or hand-authored LODs with the generated ones. Meshes with such LODs are skipped otherwise. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	bool bOverwriteCustomLODs = false;
+
+	/** The maximum number of meshes that can be building at once. 0 will use the number of available cores. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Build", meta=(ClampMin=0))
+	int32 MaxConcurrentBuilds = 0;
+};
+
+/**
+ * EUDLODGenerationStatus
+ *
+ * The outcome of the batch LOD generation for a single mesh.
+ */
+UENUM(BlueprintType)
+enum class EUDLODGenerationStatus : uint8
+{
+	Generated UMETA(Tooltip="The LODs were generated."),
+	AlreadyGenerated UMETA(Tooltip="The mesh already had the requested LODs, typically from a previous run."),
+	Skipped UMETA(Tooltip="The mesh already had enough LODs or uses Nanite."),
+	Cancelled UMETA(Tooltip="The batch was cancelled before the mesh was processed."),
+	HasCustomLODs UMETA(Tooltip="The mesh has imported or hand-authored LODs, which are only replaced when overwriting custom LODs is enabled."),
+	Failed UMETA(Tooltip="The mesh was built but its LODs were not reduced from LOD0."),
+};
+
+/**
+ * FUDLODMeshReport
+ *
+ * The result of the batch LOD generation for a single mesh.
+ */
+USTRUCT(BlueprintType)
+struct FUDLODMeshReport
+{
+	GENERATED_BODY()
+
+	/** The processed Static Mesh. */
+	UPROPERTY(BlueprintReadOnly, Category = "LOD")
+	TSoftObjectPtr<UStaticMesh> StaticMesh;
+
+	/** The outcome for this mesh. */
+	UPROPERTY(BlueprintReadOnly, Category = "LOD")
+	EUDLODGenerationStatus Status = EUDLODGenerationStatus::Cancelled;
+
+	/** The LOD count before the generation. */
+	UPROPERTY(BlueprintReadOnly, Category = "LOD")
+	int32 LODCountBefore = 0;
+
+	/** The LOD count after the generation. */
+	UPROPERTY(BlueprintReadOnly, Category = "LOD")
+	int32 LODCountAfter = 0;
+
+	/** The triangle count of LOD0. */
+	UPROPERTY(BlueprintReadOnly, Category = "LOD")
+	int32 TrianglesLOD0 = 0;
+
+	/** The triangle count of the last LOD after the generation. */
+	UPROPERTY(BlueprintReadOnly, Category = "LOD")
+	int32 TrianglesLastLOD = 0;
+};
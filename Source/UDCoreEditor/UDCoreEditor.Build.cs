@@ -24,6 +24,7 @@ public class UDCoreEditor : ModuleRules
 				"UDCore",
 				"EditorFramework",
 				"EditorScriptingUtilities",
+				"Niagara",
 			}
 		);
 	}
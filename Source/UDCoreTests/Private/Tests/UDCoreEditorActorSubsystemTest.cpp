@@ -0,0 +1,59 @@
+#if WITH_EDITOR
+
+#include "Subsystems/UDCoreEditorActorSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUDCoreEditorActorSubsystemTest, "UDCore.EditorActorSubsystemTests", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUDCoreEditorActorSubsystemTest::RunTest(const FString& Parameters)
+{
+	UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	UStaticMesh* PlaneMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Plane.Plane"));
+	if (!TestNotNull("The engine cube mesh should load", CubeMesh) || !TestNotNull("The engine plane mesh should load", PlaneMesh))
+	{
+		return false;
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Editor, false, TEXT("UDCoreEditorActorSubsystemTest"));
+
+	// The engine cube is 100 units on every axis, the engine plane is 100 by 100 units and flat.
+	AStaticMeshActor* CubeActor = World->SpawnActor<AStaticMeshActor>();
+	CubeActor->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+	AStaticMeshActor* PlaneActor = World->SpawnActor<AStaticMeshActor>();
+	PlaneActor->GetStaticMeshComponent()->SetStaticMesh(PlaneMesh);
+	const TArray<AActor*> Actors = { CubeActor, PlaneActor };
+
+	// Test FilterActorsByMeshBounds with a range only the plane is within
+	TArray<AActor*> IncludedActors;
+	UUDCoreEditorActorSubsystem::FilterActorsByMeshBounds(Actors, IncludedActors, FVector::ZeroVector, FVector(200.0f, 200.0f, 50.0f), Include);
+	TestEqual("FilterActorsByMeshBounds should include the actors within the bounds", IncludedActors, TArray<AActor*>({ PlaneActor }));
+
+	TArray<AActor*> ExcludedActors;
+	UUDCoreEditorActorSubsystem::FilterActorsByMeshBounds(Actors, ExcludedActors, FVector::ZeroVector, FVector(200.0f, 200.0f, 50.0f), Exclude);
+	TestEqual("FilterActorsByMeshBounds should exclude the actors within the bounds", ExcludedActors, TArray<AActor*>({ CubeActor }));
+
+	// Test FilterActorsByMeshBounds with a range neither mesh is within, failing on the X axis
+	TArray<AActor*> OutOfRangeActors;
+	UUDCoreEditorActorSubsystem::FilterActorsByMeshBounds(Actors, OutOfRangeActors, FVector::ZeroVector, FVector(50.0f, 200.0f, 200.0f), Exclude);
+	TestEqual("FilterActorsByMeshBounds should exclude by every axis of the bounds", OutOfRangeActors, TArray<AActor*>({ CubeActor, PlaneActor }));
+
+	// Test FilterActorsByName on actors outside the editor world, which are matched by their label
+	CubeActor->SetActorLabel(TEXT("Test_Cube"));
+	PlaneActor->SetActorLabel(TEXT("Test_Plane"));
+	TArray<AActor*> NamedActors;
+	UUDCoreEditorActorSubsystem::FilterActorsByName(Actors, NamedActors, TEXT("cube"), Include);
+	TestEqual("FilterActorsByName should include the actors containing the name", NamedActors, TArray<AActor*>({ CubeActor }));
+
+	TArray<AActor*> UnnamedActors;
+	UUDCoreEditorActorSubsystem::FilterActorsByName(Actors, UnnamedActors, TEXT("cube"), Exclude);
+	TestEqual("FilterActorsByName should exclude the actors containing the name", UnnamedActors, TArray<AActor*>({ PlaneActor }));
+
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
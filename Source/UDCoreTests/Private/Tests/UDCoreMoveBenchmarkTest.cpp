@@ -0,0 +1,310 @@
+#include "AI/UDAT_MoveToLocation.h"
+#include "AI/UDCoreMoveSubsystem.h"
+#include "Tests/UDCoreTestObject.h"
+#include "AIController.h"
+#include "Components/BrushComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "NavigationSystem.h"
+#include "NavMesh/NavMeshBoundsVolume.h"
+#include "NavMesh/RecastNavMesh.h"
+#include "UObject/UObjectArray.h"
+
+#if WITH_EDITOR
+#include "Builders/CubeBuilder.h"
+#endif
+
+namespace UDCoreMoveBenchmark
+{
+	constexpr float AgentSpacing = 150.0f;
+	constexpr float FixedDeltaTime = 1.0f / 30.0f;
+	constexpr int32 MaxFrames = 30 * 60;
+	constexpr double HitchMultiplier = 3.0;
+
+	/** The share of agents that must arrive for a run to be valid. The floor is open, so only a broken navmesh or subsystem fails more. */
+	constexpr double MinArrivalRate = 0.9;
+
+	/** The results of one benchmark run, written as one CSV row. */
+	struct FResults
+	{
+		int32 NumAgents = 0;
+		int32 NumFrames = 0;
+		double AverageFrameMs = 0.0;
+		double MaxFrameMs = 0.0;
+		int32 NumHitches = 0;
+		double AverageBookkeepingUs = 0.0;
+		double MaxBookkeepingUs = 0.0;
+		double AverageChecksPerFrame = 0.0;
+		int32 MaxActiveMoves = 0;
+		int32 NumObjectsAllocated = 0;
+		int64 MemoryDeltaKB = 0;
+		int32 NumSucceeded = 0;
+		int32 NumFailed = 0;
+		double SimulatedSeconds = 0.0;
+	};
+
+	/** Creates a game world the benchmark can tick on its own, outside of any play session. */
+	UWorld* CreateBenchmarkWorld()
+	{
+		UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("UDCoreMoveBenchmark"));
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+
+		// The async actions register with the game instance of the world to stay alive while moving.
+		World->SetGameInstance(NewObject<UGameInstance>(GEngine));
+		World->InitializeActorsForPlay(FURL());
+		FNavigationSystem::AddNavigationSystemToWorld(*World, FNavigationSystemRunMode::GameMode);
+		World->GetWorldSettings()->NotifyBeginPlay();
+		return World;
+	}
+
+	void DestroyBenchmarkWorld(UWorld* World)
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	/** Spawns a floor of the provided half extent and builds a navmesh over it. Returns false if the navmesh could not be built. */
+	bool BuildNavigableFloor(UWorld* World, const float HalfExtent)
+	{
+#if WITH_EDITOR
+		UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+		if (!CubeMesh) { return false; }
+
+		// The engine cube is 100 units wide and centered on its pivot.
+		AStaticMeshActor* Floor = World->SpawnActor<AStaticMeshActor>(FVector(0.0f, 0.0f, -50.0f), FRotator::ZeroRotator);
+		Floor->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+		Floor->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+		Floor->SetActorScale3D(FVector(HalfExtent / 50.0f, HalfExtent / 50.0f, 1.0f));
+
+		ANavMeshBoundsVolume* BoundsVolume = World->SpawnActor<ANavMeshBoundsVolume>(FVector::ZeroVector, FRotator::ZeroRotator);
+		UCubeBuilder* CubeBuilder = NewObject<UCubeBuilder>();
+		CubeBuilder->X = HalfExtent * 2.0f + 200.0f;
+		CubeBuilder->Y = HalfExtent * 2.0f + 200.0f;
+		CubeBuilder->Z = 1000.0f;
+		CubeBuilder->Build(World, BoundsVolume);
+		BoundsVolume->GetBrushComponent()->Brush = BoundsVolume->Brush;
+		BoundsVolume->GetBrushComponent()->UpdateBounds();
+
+		UNavigationSystemV1* NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+		if (!NavigationSystem) { return false; }
+
+		// The first build spawns and registers the navmesh of the benchmark world.
+		NavigationSystem->OnNavigationBoundsUpdated(BoundsVolume);
+		NavigationSystem->Build();
+
+		ARecastNavMesh* NavMesh = Cast<ARecastNavMesh>(NavigationSystem->GetDefaultNavDataInstance());
+		if (!NavMesh) { return false; }
+
+		// Static navmeshes have no generator in game worlds, so the navmesh of this world is made dynamic and rebuilt.
+		// Only this instance is changed, the class default and the navmeshes of other worlds keep their settings.
+		const FProperty* RuntimeGenerationProperty = FindFProperty<FProperty>(ANavigationData::StaticClass(), TEXT("RuntimeGeneration"));
+		if (!RuntimeGenerationProperty) { return false; }
+		*RuntimeGenerationProperty->ContainerPtrToValuePtr<ERuntimeGenerationType>(NavMesh) = ERuntimeGenerationType::Dynamic;
+		NavigationSystem->Build();
+
+		return NavMesh->GetNavMeshTilesCount() > 0;
+#else
+		return false;
+#endif
+	}
+
+	/** Appends the results to Saved/UDCore/MoveBenchmark.csv, writing the header if the file is new. */
+	void WriteResults(const FResults& Results)
+	{
+		const FString CsvPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UDCore"), TEXT("MoveBenchmark.csv"));
+		const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("UDCore"));
+
+		FString Csv;
+		if (!IFileManager::Get().FileExists(*CsvPath))
+		{
+			Csv += TEXT("Timestamp,PluginVersion,EngineVersion,Agents,Frames,SimulatedSeconds,AvgFrameMs,MaxFrameMs,Hitches,")
+				TEXT("AvgBookkeepingUs,MaxBookkeepingUs,AvgChecksPerFrame,MaxActiveMoves,ObjectsAllocated,MemoryDeltaKB,")
+				TEXT("Succeeded,Failed,ArrivalRate\n");
+		}
+
+		Csv += FString::Printf(
+			TEXT("%s,%s,%s,%d,%d,%.2f,%.3f,%.3f,%d,%.2f,%.2f,%.1f,%d,%d,%lld,%d,%d,%.3f\n"),
+			*FDateTime::UtcNow().ToIso8601(),
+			Plugin.IsValid() ? *Plugin->GetDescriptor().VersionName : TEXT("Unknown"),
+			*FEngineVersion::Current().ToString(EVersionComponent::Patch),
+			Results.NumAgents,
+			Results.NumFrames,
+			Results.SimulatedSeconds,
+			Results.AverageFrameMs,
+			Results.MaxFrameMs,
+			Results.NumHitches,
+			Results.AverageBookkeepingUs,
+			Results.MaxBookkeepingUs,
+			Results.AverageChecksPerFrame,
+			Results.MaxActiveMoves,
+			Results.NumObjectsAllocated,
+			Results.MemoryDeltaKB,
+			Results.NumSucceeded,
+			Results.NumFailed,
+			Results.NumAgents > 0 ? static_cast<double>(Results.NumSucceeded) / Results.NumAgents : 0.0);
+
+		FFileHelper::SaveStringToFile(Csv, *CsvPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append);
+	}
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FUDCoreMoveBenchmarkTest, "UDCore.MoveBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+void FUDCoreMoveBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const int32 NumAgents : {100, 1000, 5000})
+	{
+		OutBeautifiedNames.Add(FString::Printf(TEXT("%d Agents"), NumAgents));
+		OutTestCommands.Add(FString::FromInt(NumAgents));
+	}
+}
+
+bool FUDCoreMoveBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace UDCoreMoveBenchmark;
+
+	FResults Results;
+	Results.NumAgents = FCString::Atoi(*Parameters);
+	if (!TestTrue("The benchmark should be given a number of agents", Results.NumAgents > 0)) { return false; }
+
+	// Lay the agents out on a square grid and send each one to the mirrored cell on the other side of the floor.
+	const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Results.NumAgents)));
+	const float HalfExtent = GridSize * AgentSpacing * 0.5f + AgentSpacing;
+
+	UWorld* World = CreateBenchmarkWorld();
+	if (!BuildNavigableFloor(World, HalfExtent))
+	{
+		AddError(TEXT("Could not build a navmesh for the benchmark floor. The benchmark requires an editor build."));
+		DestroyBenchmarkWorld(World);
+		return false;
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	TArray<AController*> Controllers;
+	TArray<FVector> Destinations;
+	Controllers.Reserve(Results.NumAgents);
+	Destinations.Reserve(Results.NumAgents);
+	for (int32 AgentIndex = 0; AgentIndex < Results.NumAgents; ++AgentIndex)
+	{
+		const FVector Offset((AgentIndex % GridSize - (GridSize - 1) * 0.5f) * AgentSpacing, (AgentIndex / GridSize - (GridSize - 1) * 0.5f) * AgentSpacing, 0.0f);
+		ACharacter* Character = World->SpawnActor<ACharacter>(Offset + FVector(0.0f, 0.0f, 100.0f), FRotator::ZeroRotator, SpawnParameters);
+
+		// The agents cross each other's paths, the benchmark measures the task bookkeeping rather than avoidance.
+		Character->GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+		Character->AIControllerClass = AAIController::StaticClass();
+		Character->SpawnDefaultController();
+
+		Controllers.Add(Character->GetController());
+		Destinations.Add(FVector(-Offset.X, -Offset.Y, 0.0f));
+	}
+
+	// Let the characters land on the floor before moving them.
+	for (int32 Frame = 0; Frame < 10; ++Frame)
+	{
+		World->Tick(LEVELTICK_All, FixedDeltaTime);
+	}
+
+	UUDCoreMoveTestListener* Listener = NewObject<UUDCoreMoveTestListener>();
+	TArray<UUDAT_MoveToLocation*> Actions;
+	Actions.Reserve(Results.NumAgents);
+
+	const int32 ObjectsBefore = GUObjectArray.GetObjectArrayNumMinusAvailable();
+	const uint64 MemoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+	for (int32 AgentIndex = 0; AgentIndex < Results.NumAgents; ++AgentIndex)
+	{
+		UUDAT_MoveToLocation* Action = UUDAT_MoveToLocation::MoveToLocation(World, Controllers[AgentIndex], Destinations[AgentIndex], 100.0f, true, 1.0f, false, true);
+		Action->Completed.AddDynamic(Listener, &UUDCoreMoveTestListener::OnMoveCompleted);
+		Action->Activate();
+		Actions.Add(Action);
+	}
+
+	const UUDCoreMoveSubsystem* MoveSubsystem = World->GetSubsystem<UUDCoreMoveSubsystem>();
+	TArray<double> FrameTimesMs;
+	FrameTimesMs.Reserve(MaxFrames);
+	double TotalBookkeepingUs = 0.0;
+	int64 TotalChecks = 0;
+	while (Results.NumFrames < MaxFrames && Listener->NumSucceeded + Listener->NumFailed < Results.NumAgents)
+	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		World->Tick(LEVELTICK_All, FixedDeltaTime);
+		FrameTimesMs.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+
+		const FUDMoveSchedulerStats& FrameStats = MoveSubsystem->GetLastFrameStats();
+		TotalBookkeepingUs += FrameStats.ElapsedMicroseconds;
+		TotalChecks += FrameStats.NumChecks;
+		Results.MaxBookkeepingUs = FMath::Max(Results.MaxBookkeepingUs, FrameStats.ElapsedMicroseconds);
+		Results.MaxActiveMoves = FMath::Max(Results.MaxActiveMoves, MoveSubsystem->GetNumActiveMoves());
+		++Results.NumFrames;
+	}
+
+	Results.NumObjectsAllocated = GUObjectArray.GetObjectArrayNumMinusAvailable() - ObjectsBefore;
+	Results.MemoryDeltaKB = (static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - static_cast<int64>(MemoryBefore)) / 1024;
+	Results.NumSucceeded = Listener->NumSucceeded;
+	Results.NumFailed = Listener->NumFailed;
+	Results.SimulatedSeconds = Results.NumFrames * FixedDeltaTime;
+
+	if (Results.NumFrames > 0)
+	{
+		TArray<double> SortedFrameTimesMs = FrameTimesMs;
+		SortedFrameTimesMs.Sort();
+		const double MedianFrameMs = SortedFrameTimesMs[SortedFrameTimesMs.Num() / 2];
+
+		double TotalFrameMs = 0.0;
+		for (const double FrameMs : FrameTimesMs)
+		{
+			TotalFrameMs += FrameMs;
+			Results.MaxFrameMs = FMath::Max(Results.MaxFrameMs, FrameMs);
+			Results.NumHitches += FrameMs > MedianFrameMs * HitchMultiplier ? 1 : 0;
+		}
+
+		Results.AverageFrameMs = TotalFrameMs / Results.NumFrames;
+		Results.AverageBookkeepingUs = TotalBookkeepingUs / Results.NumFrames;
+		Results.AverageChecksPerFrame = static_cast<double>(TotalChecks) / Results.NumFrames;
+	}
+
+	// End the tasks that did not complete in time after their results were counted.
+	for (UUDAT_MoveToLocation* Action : Actions)
+	{
+		Action->Completed.RemoveAll(Listener);
+		Action->EndTask();
+	}
+
+	AddInfo(FString::Printf(
+		TEXT("%d agents: %d/%d arrived in %.1fs, %.3fms average frame, %.2fus average bookkeeping, %d hitches."),
+		Results.NumAgents,
+		Results.NumSucceeded,
+		Results.NumAgents,
+		Results.SimulatedSeconds,
+		Results.AverageFrameMs,
+		Results.AverageBookkeepingUs,
+		Results.NumHitches));
+
+	// Only valid runs are recorded, so a broken navmesh or a regression cannot pass as a fast run.
+	const double ArrivalRate = static_cast<double>(Results.NumSucceeded) / Results.NumAgents;
+	bool bValidRun = TestTrue("Every agent should complete its move request within the time cap", Results.NumSucceeded + Results.NumFailed == Results.NumAgents);
+	bValidRun &= TestTrue("At least one agent should arrive", Results.NumSucceeded > 0);
+	bValidRun &= TestTrue(FString::Printf(TEXT("At least %.0f%% of the agents should arrive, %.1f%% did"), MinArrivalRate * 100.0, ArrivalRate * 100.0), ArrivalRate >= MinArrivalRate);
+	if (bValidRun)
+	{
+		WriteResults(Results);
+	}
+
+	DestroyBenchmarkWorld(World);
+	return bValidRun;
+}
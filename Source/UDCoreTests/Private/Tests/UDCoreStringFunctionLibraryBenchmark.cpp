@@ -0,0 +1,110 @@
+#include "Libraries/UDCoreStringFunctionLibrary.h"
+#include "Misc/AutomationTest.h"
+#include "Algo/Sort.h"
+
+namespace UDCoreStringBenchmark
+{
+	/** Returns a string of the provided length made of a name-like pattern of letters, digits, spaces and punctuation. */
+	FString MakeBenchmarkString(const int32 Length, const bool bNonAscii)
+	{
+		static const TCHAR Pattern[] = TEXT("PlayerName_42 the Brave");
+		FString String;
+		String.Reserve(Length);
+		for (int32 Index = 0; Index < Length; ++Index)
+		{
+			String.AppendChar(Pattern[Index % (UE_ARRAY_COUNT(Pattern) - 1)]);
+		}
+
+		if (bNonAscii && Length > 0)
+		{
+			String[Length / 2] = TEXT('\u00E9');
+		}
+		return String;
+	}
+
+	/** The scalar loop the Contains functions used before they were vectorized. */
+	bool ScalarContainsSpecialCharacters(const FString& String)
+	{
+		for (const TCHAR Char : String)
+		{
+			if (FChar::IsPunct(Char)) { return true; }
+		}
+		return false;
+	}
+
+	/** Returns the average time in nanoseconds of one call of the function on the string. */
+	template <typename FunctionType>
+	double TimeCalls(const FString& String, const int32 NumCalls, FunctionType Function)
+	{
+		int32 NumTrue = 0;
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		for (int32 Call = 0; Call < NumCalls; ++Call)
+		{
+			NumTrue += Function(String) ? 1 : 0;
+		}
+		const double ElapsedNs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000000.0;
+
+		// Keep the result alive so the calls are not optimized away.
+		check(NumTrue >= 0);
+		return ElapsedNs / NumCalls;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUDCoreStringFunctionLibraryBenchmark, "UDCore.StringFunctionLibraryBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FUDCoreStringFunctionLibraryBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace UDCoreStringBenchmark;
+
+	// Special characters are searched in strings without any, so every character is classified.
+	for (const int32 Length : {16, 256, 65536})
+	{
+		for (const bool bNonAscii : {false, true})
+		{
+			const FString String = MakeBenchmarkString(Length, bNonAscii).Replace(TEXT("_"), TEXT("x"));
+			const int32 NumCalls = FMath::Max(1, 16 * 1024 * 1024 / Length);
+
+			const double ScalarNs = TimeCalls(String, NumCalls, &ScalarContainsSpecialCharacters);
+			const double LibraryNs = TimeCalls(String, NumCalls, &UUDCoreStringFunctionLibrary::ContainsSpecialCharacters);
+
+			AddInfo(FString::Printf(
+				TEXT("ContainsSpecialCharacters on %d characters%s: %.1fns scalar, %.1fns library, %.2fx speedup."),
+				Length,
+				bNonAscii ? TEXT(" with a non-ASCII character") : TEXT(""),
+				ScalarNs,
+				LibraryNs,
+				LibraryNs > 0.0 ? ScalarNs / LibraryNs : 0.0));
+
+			TestEqual("ContainsSpecialCharacters should match the scalar loop", UUDCoreStringFunctionLibrary::ContainsSpecialCharacters(String), ScalarContainsSpecialCharacters(String));
+		}
+	}
+
+	// Sort a million asset-like names with Algo::Sort and with each sort mode.
+	FRandomStream RandomStream(1337);
+	TArray<FString> Names;
+	Names.Reserve(1000000);
+	for (int32 Index = 0; Index < 1000000; ++Index)
+	{
+		Names.Add(FString::Printf(TEXT("SM_Prop_%d_LOD%d"), RandomStream.RandRange(0, 999999), RandomStream.RandRange(0, 3)));
+	}
+
+	{
+		TArray<FString> SortedNames = Names;
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		Algo::Sort(SortedNames);
+		AddInfo(FString::Printf(TEXT("Algo::Sort of %d names: %.1fms."), Names.Num(), FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles)));
+	}
+
+	for (const EUDCoreStringSortMode SortMode : { EUDCoreStringSortMode::CaseInsensitive, EUDCoreStringSortMode::CaseSensitive, EUDCoreStringSortMode::Natural, EUDCoreStringSortMode::Locale })
+	{
+		TArray<FString> SortedNames = Names;
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		UUDCoreStringFunctionLibrary::SortStringArrayInPlace(SortedNames, SortMode);
+		AddInfo(FString::Printf(TEXT("SortStringArrayInPlace of %d names with %s: %.1fms."),
+			Names.Num(),
+			*StaticEnum<EUDCoreStringSortMode>()->GetNameStringByValue(static_cast<int64>(SortMode)),
+			FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles)));
+	}
+
+	return true;
+}
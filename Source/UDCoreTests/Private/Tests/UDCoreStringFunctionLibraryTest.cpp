@@ -1,5 +1,7 @@
 #include "Libraries/UDCoreStringFunctionLibrary.h"
 #include "Misc/AutomationTest.h"
+#include "Algo/Sort.h"
+#include "Algo/StableSort.h"
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUDCoreStringFunctionLibraryTest, "UDCore.StringFunctionLibraryTests", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
 
@@ -21,14 +23,156 @@ bool FUDCoreStringFunctionLibraryTest::RunTest(const FString& Parameters)
     TestTrue("ContainsSpecialCharacters should return true for 'Hello!'", UUDCoreStringFunctionLibrary::ContainsSpecialCharacters(TEXT("Hello!")));
     TestFalse("ContainsSpecialCharacters should return false for 'Hello'", UUDCoreStringFunctionLibrary::ContainsSpecialCharacters(TEXT("Hello")));
 
+    // Test the Contains functions on both sides of the vectorized chunks, with and without non-ASCII characters
+    const TArray<FString> ChunkedStrings = {
+        TEXT("abcdefgh"),
+        TEXT("abcdefgh1"),
+        TEXT("        \t"),
+        TEXT("ABCDEFG\u00E9abcdefg!"),
+        TEXT("\u00E9\u00E8\u00EA\u00EB\u00E0\u00E2\u00E4\u00F4 "),
+        TEXT("0123456789012345"),
+        TEXT("\x01\x02\x03\x04\x05\x06\x07\x7F@[`{"),
+    };
+    for (const FString& String : ChunkedStrings)
+    {
+        bool bExpectedLetters = false, bExpectedNumbers = false, bExpectedSpaces = false, bExpectedSpecialCharacters = false;
+        for (const TCHAR Char : String)
+        {
+            bExpectedLetters |= FChar::IsAlpha(Char);
+            bExpectedNumbers |= FChar::IsDigit(Char);
+            bExpectedSpaces |= FChar::IsWhitespace(Char);
+            bExpectedSpecialCharacters |= FChar::IsPunct(Char);
+        }
+
+        TestEqual(FString::Printf(TEXT("ContainsLetters should match FChar::IsAlpha for '%s'"), *String), UUDCoreStringFunctionLibrary::ContainsLetters(String), bExpectedLetters);
+        TestEqual(FString::Printf(TEXT("ContainsNumbers should match FChar::IsDigit for '%s'"), *String), UUDCoreStringFunctionLibrary::ContainsNumbers(String), bExpectedNumbers);
+        TestEqual(FString::Printf(TEXT("ContainsSpaces should match FChar::IsWhitespace for '%s'"), *String), UUDCoreStringFunctionLibrary::ContainsSpaces(String), bExpectedSpaces);
+        TestEqual(FString::Printf(TEXT("ContainsSpecialCharacters should match FChar::IsPunct for '%s'"), *String), UUDCoreStringFunctionLibrary::ContainsSpecialCharacters(String), bExpectedSpecialCharacters);
+
+        const FUDCoreCharacterProfile ChunkedProfile = UUDCoreStringFunctionLibrary::GetCharacterProfile(String);
+        TestTrue(FString::Printf(TEXT("GetCharacterProfile should match the Contains functions for '%s'"), *String),
+            ChunkedProfile.HasAny(EUDCoreCharacterClass::Letter) == bExpectedLetters && ChunkedProfile.HasAny(EUDCoreCharacterClass::Digit) == bExpectedNumbers
+            && ChunkedProfile.HasAny(EUDCoreCharacterClass::Whitespace) == bExpectedSpaces && ChunkedProfile.HasAny(EUDCoreCharacterClass::Punctuation) == bExpectedSpecialCharacters);
+    }
+
+    // Test GetCharacterProfile
+    const FUDCoreCharacterProfile Profile = UUDCoreStringFunctionLibrary::GetCharacterProfile(TEXT("Player_42 \u00C9lan!\t"));
+    TestEqual("GetCharacterProfile should count every character", Profile.NumCharacters, 16);
+    TestEqual("GetCharacterProfile should count the letters", Profile.NumLetters, FChar::IsAlpha(TEXT('\u00C9')) ? 10 : 9);
+    TestEqual("GetCharacterProfile should count the digits", Profile.NumDigits, 2);
+    TestEqual("GetCharacterProfile should count the whitespace", Profile.NumWhitespace, 2);
+    TestEqual("GetCharacterProfile should count the punctuation", Profile.NumPunctuation, 2);
+    TestEqual("GetCharacterProfile should count the non-ASCII characters", Profile.NumNonAscii, 1);
+    TestTrue("CharacterProfileContainsAny should find digits", UUDCoreStringFunctionLibrary::CharacterProfileContainsAny(Profile, static_cast<int32>(EUDCoreCharacterClass::Digit)));
+    TestFalse("CharacterProfileContainsAny should not find control characters", UUDCoreStringFunctionLibrary::CharacterProfileContainsAny(Profile, static_cast<int32>(EUDCoreCharacterClass::Control)));
+    TestFalse("CharacterProfileContainsOnly should reject punctuation", UUDCoreStringFunctionLibrary::CharacterProfileContainsOnly(Profile, static_cast<int32>(EUDCoreCharacterClass::Letter | EUDCoreCharacterClass::Digit | EUDCoreCharacterClass::NonAscii)));
+    TestTrue("CharacterProfileContainsOnly should accept every class it holds", UUDCoreStringFunctionLibrary::CharacterProfileContainsOnly(Profile, static_cast<int32>(EUDCoreCharacterClass::Letter | EUDCoreCharacterClass::Digit | EUDCoreCharacterClass::Whitespace | EUDCoreCharacterClass::Punctuation | EUDCoreCharacterClass::NonAscii)));
+
+    // Non-ASCII letters only need the Letter class, and characters in no other class need the NonAscii class
+    const FUDCoreCharacterProfile NameProfile = UUDCoreStringFunctionLibrary::GetCharacterProfile(TEXT("Jos\u00E9"));
+    TestEqual("GetCharacterProfile should count the unclassified characters", NameProfile.NumUnclassified, FChar::IsAlpha(TEXT('\u00E9')) ? 0 : 1);
+    TestEqual("CharacterProfileContainsOnly should accept non-ASCII letters as letters", UUDCoreStringFunctionLibrary::CharacterProfileContainsOnly(NameProfile, static_cast<int32>(EUDCoreCharacterClass::Letter)), FChar::IsAlpha(TEXT('\u00E9')));
+    TestTrue("CharacterProfileContainsOnly should accept unclassified characters with NonAscii", UUDCoreStringFunctionLibrary::CharacterProfileContainsOnly(NameProfile, static_cast<int32>(EUDCoreCharacterClass::Letter | EUDCoreCharacterClass::NonAscii)));
+
     // Test FilterCharacters
     const FString FilteredString = UUDCoreStringFunctionLibrary::FilterCharacters(TEXT("Hello123! "), true, true, true, true);
     TestEqual("FilterCharacters should return an empty string", FilteredString, TEXT(""));
 
+    // Test the FilterCharacters variants against a scalar filter, across chunk boundaries and with non-ASCII characters
+    const FString MixedString = TEXT("Player_42 the \u00C9lan, level 1337!\tGuild: [Dragons]   ");
+    FString ExpectedString;
+    for (const TCHAR Char : MixedString)
+    {
+        if (!FChar::IsDigit(Char) && !FChar::IsPunct(Char)) { ExpectedString.AppendChar(Char); }
+    }
+
+    TestEqual("FilterCharacters should remove digits and punctuation", UUDCoreStringFunctionLibrary::FilterCharacters(MixedString, false, true, true, false), ExpectedString);
+
+    FString InPlaceString = MixedString;
+    UUDCoreStringFunctionLibrary::FilterCharactersInPlace(InPlaceString, false, true, true, false);
+    TestEqual("FilterCharactersInPlace should remove digits and punctuation", InPlaceString, ExpectedString);
+
+    TStringBuilder<64> Builder;
+    Builder << TEXT(">");
+    UUDCoreStringFunctionLibrary::FilterCharacters(MixedString, false, true, true, false, Builder);
+    TestEqual("FilterCharacters should append to the string builder", FString(Builder.ToView()), TEXT(">") + ExpectedString);
+
+    TArray<TCHAR> Buffer;
+    Buffer.SetNumUninitialized(MixedString.Len());
+    const int32 NumWritten = UUDCoreStringFunctionLibrary::FilterCharacters(MixedString, false, true, true, false, Buffer);
+    TestEqual("FilterCharacters should write to the buffer", FString(NumWritten, Buffer.GetData()), ExpectedString);
+
+    FString UnfilteredString = MixedString;
+    UUDCoreStringFunctionLibrary::FilterCharactersInPlace(UnfilteredString, false, false, false, false);
+    TestEqual("FilterCharactersInPlace should keep the string when nothing is filtered", UnfilteredString, MixedString);
+
+    // Test the batch functions against the single string functions, with enough strings to span several batches
+    TArray<FString> BatchStrings;
+    for (int32 Index = 0; Index < 4096; ++Index)
+    {
+        BatchStrings.Add(Index % 3 == 0 ? FString::Printf(TEXT("Name %d!"), Index) : FString::Printf(TEXT("\u00C9lan_%s"), *FString::ChrN(Index % 17, TEXT('x'))));
+    }
+
+    const TArray<FString> FilteredBatch = UUDCoreStringFunctionLibrary::FilterCharactersBatch(BatchStrings, false, true, true, false);
+    const TArray<bool> ContainsBatch = UUDCoreStringFunctionLibrary::ContainsCharacterClassesBatch(BatchStrings, static_cast<int32>(EUDCoreCharacterClass::Digit));
+    const TArray<FUDCoreCharacterProfile> ProfileBatch = UUDCoreStringFunctionLibrary::GetCharacterProfileBatch(BatchStrings);
+    TestEqual("FilterCharactersBatch should return a string per input string", FilteredBatch.Num(), BatchStrings.Num());
+    TestEqual("ContainsCharacterClassesBatch should return a result per input string", ContainsBatch.Num(), BatchStrings.Num());
+    TestEqual("GetCharacterProfileBatch should return a profile per input string", ProfileBatch.Num(), BatchStrings.Num());
+
+    bool bBatchMatches = FilteredBatch.Num() == BatchStrings.Num() && ContainsBatch.Num() == BatchStrings.Num() && ProfileBatch.Num() == BatchStrings.Num();
+    for (int32 Index = 0; bBatchMatches && Index < BatchStrings.Num(); ++Index)
+    {
+        bBatchMatches = FilteredBatch[Index] == UUDCoreStringFunctionLibrary::FilterCharacters(BatchStrings[Index], false, true, true, false)
+            && ContainsBatch[Index] == UUDCoreStringFunctionLibrary::ContainsNumbers(BatchStrings[Index])
+            && ProfileBatch[Index].NumCharacters == BatchStrings[Index].Len()
+            && ProfileBatch[Index].NumPunctuation == UUDCoreStringFunctionLibrary::GetCharacterProfile(BatchStrings[Index]).NumPunctuation;
+    }
+    TestTrue("The batch functions should match the single string functions", bBatchMatches);
+
     // Test GetSortedStringArray
     const TArray<FString> UnsortedArray = { TEXT("Banana"), TEXT("Apple"), TEXT("Cherry") };
     const TArray<FString> SortedArray = UUDCoreStringFunctionLibrary::GetSortedStringArray(UnsortedArray);
     TestEqual("GetSortedStringArray should return a sorted array", SortedArray, TArray<FString>({ TEXT("Apple"), TEXT("Banana"), TEXT("Cherry") }));
 
+    // Test the sort modes. FString's operator== ignores case, so the orders are compared case sensitively.
+    const auto EqualsCaseSensitive = [](const TArray<FString>& A, const TArray<FString>& B)
+    {
+        if (A.Num() != B.Num()) { return false; }
+        for (int32 Index = 0; Index < A.Num(); ++Index)
+        {
+            if (!A[Index].Equals(B[Index], ESearchCase::CaseSensitive)) { return false; }
+        }
+        return true;
+    };
+
+    const TArray<FString> ItemArray = { TEXT("item10"), TEXT("Item2"), TEXT("item1"), TEXT("Item02"), TEXT("Item"), TEXT("item2") };
+    TestTrue("GetSortedStringArray should sort case sensitively", EqualsCaseSensitive(UUDCoreStringFunctionLibrary::GetSortedStringArray(ItemArray, EUDCoreStringSortMode::CaseSensitive),
+        TArray<FString>({ TEXT("Item"), TEXT("Item02"), TEXT("Item2"), TEXT("item1"), TEXT("item10"), TEXT("item2") })));
+    TestTrue("GetSortedStringArray should sort case insensitively and keep equal strings in order", EqualsCaseSensitive(UUDCoreStringFunctionLibrary::GetSortedStringArray(ItemArray, EUDCoreStringSortMode::CaseInsensitive),
+        TArray<FString>({ TEXT("Item"), TEXT("Item02"), TEXT("item1"), TEXT("item10"), TEXT("Item2"), TEXT("item2") })));
+    TestTrue("GetSortedStringArray should sort numbers by value", EqualsCaseSensitive(UUDCoreStringFunctionLibrary::GetSortedStringArray(ItemArray, EUDCoreStringSortMode::Natural),
+        TArray<FString>({ TEXT("Item"), TEXT("item1"), TEXT("Item2"), TEXT("item2"), TEXT("Item02"), TEXT("item10") })));
+
+    TArray<FString> InPlaceArray = ItemArray;
+    UUDCoreStringFunctionLibrary::SortStringArrayInPlace(InPlaceArray, EUDCoreStringSortMode::Natural);
+    TestTrue("SortStringArrayInPlace should match GetSortedStringArray", EqualsCaseSensitive(InPlaceArray, UUDCoreStringFunctionLibrary::GetSortedStringArray(ItemArray, EUDCoreStringSortMode::Natural)));
+
+    // Test the parallel sort against a stable sort with the default FString ordering, with strings only differing by case
+    FRandomStream RandomStream(1337);
+    TArray<FString> LargeArray;
+    for (int32 Index = 0; Index < 100000; ++Index)
+    {
+        LargeArray.Add(FString::Printf(TEXT("Asset_%c%c_%08x"), TEXT('A') + RandomStream.RandRange(0, 25), TEXT('a') + RandomStream.RandRange(0, 25), Index * 2654435761u));
+        if (Index % 3 == 0)
+        {
+            LargeArray.Add(LargeArray.Last().ToUpper());
+        }
+    }
+    TArray<FString> ExpectedLargeArray = LargeArray;
+    Algo::StableSort(ExpectedLargeArray);
+    UUDCoreStringFunctionLibrary::SortStringArrayInPlace(LargeArray);
+    TestTrue("SortStringArrayInPlace should stably sort large arrays like the default FString ordering", EqualsCaseSensitive(LargeArray, ExpectedLargeArray));
+
     return true;
 }
\ No newline at end of file
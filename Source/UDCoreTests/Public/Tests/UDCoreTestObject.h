@@ -12,4 +12,23 @@ class UUDCoreTestObject : public UObject
 public:
 	UPROPERTY()
 	TArray<int32> TestArray;
-};
\ No newline at end of file
+};
+
+/**
+ * Counts the completions of the move tasks started by the move benchmark.
+ */
+UCLASS()
+class UUDCoreMoveTestListener : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	int32 NumSucceeded = 0;
+	int32 NumFailed = 0;
+
+	UFUNCTION()
+	void OnMoveCompleted(bool bSuccess)
+	{
+		++(bSuccess ? NumSucceeded : NumFailed);
+	}
+};
@@ -19,13 +19,17 @@ public class UDCoreTests : ModuleRules
                 "CoreUObject",
                 "Engine",
                 "UDCore",
-                "AutomationTest"
+                "AutomationTest",
+                "AIModule",
+                "NavigationSystem",
+                "Projects"
             }
         );
         
         if (Target.bBuildEditor)
         {
             PrivateDependencyModuleNames.Add("UDCoreEditor");
+            PrivateDependencyModuleNames.Add("UnrealEd");
         }
     }
 }
\ No newline at end of file